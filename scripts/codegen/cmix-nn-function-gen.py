@@ -1,5 +1,7 @@
 import errno
+import itertools
 import os
+from functools import partial
 from mako.template import Template
 
 
@@ -18,11 +20,74 @@ CMixNNSrcDirs = {'Include': CMixNNInstallPath + "inc",
                 'convolution': CMixNNInstallPath + "src/ConvolutionFunctions/",
                 'fullyConnected': CMixNNInstallPath + "src/FullyConnectedFunctions/",
                 'Pooling': CMixNNInstallPath + "src/PoolingFunctions/",
-                'NNSupport': CMixNNInstallPath + "src/NNSupportFunctions/"}
+                'NNSupport': CMixNNInstallPath + "src/NNSupportFunctions/",
+                'BasicMath': CMixNNInstallPath + "src/BasicMathFunctions/",
+                'Softmax': CMixNNInstallPath + "src/SoftmaxFunctions/"}
 CMixNNDataPrecisions = ['u8', 'u4', 'u2']
+# signed symmetric weights (no offset), plain convolution and matmul only
+CMixNNSignedDataPrecisions = ['s8', 's4', 's2']
+CMixNNWtPrecisions = CMixNNDataPrecisions + CMixNNSignedDataPrecisions
+# signed activations, plain convolution, depthwise and matmul only
+CMixNNActPrecisions = CMixNNDataPrecisions + CMixNNSignedDataPrecisions
+# raw accumulator outputs (no requantization, int16 with a single rounding shift), plain convolution and depthwise only
+CMixNNRawPrecisions = ['int32', 'int16']
+# logits of the softmax (packed activations or raw accumulators)
+CMixNNSoftmaxPrecisions = ['u8', 'u4', 'int32']
 CMixNNQuantizationMethods = ['PACT', 'PACT_CH']
-CMixNNFoldingMethods = ['weights', 'icn'] 
-CMixNNConstrains = {'u8': 4, 'u4': 8, 'u2': 16}
+CMixNNFoldingMethods = ['weights', 'icn', 'thr']
+# shift-only requantization of the layers with a power-of-two scale, plain convolution, depthwise and matmul only
+CMixNNPow2FoldingMethods = CMixNNFoldingMethods + ['pow2']
+# ICN with packed per-channel requantization records, plain convolution and matmul only
+CMixNNRecFoldingMethods = CMixNNPow2FoldingMethods + ['icn_rec']
+CMixNNConstrains = {'u8': 4, 'u4': 8, 'u2': 16, 's8': 4, 's4': 8, 's2': 16}
+CMixNNChInConstrains = {'u8': 1, 'u4': 2, 'u2': 4, 's8': 1, 's4': 2, 's2': 4}
+CMixNNChOutConstrains = {'u8': 2, 'u4': 2, 'u2': 4, 's8': 2, 's4': 2, 's2': 4, 'int32': 2, 'int16': 2}
+
+
+def CMixNNFoldingSupported(out_data_t, quantization, folding):
+    """PACT_CH needs per-channel folding, records only with PACT_CH, thresholds only quantize to u4/u2"""
+    return ((quantization == "PACT_CH" and folding in ("icn", "icn_rec", "thr")) or
+            (quantization == "PACT" and folding != "icn_rec")) and \
+        (folding != "thr" or out_data_t != "u8")
+
+
+def CMixNNWeightsSupported(wt_data_t, folding):
+    """Signed weights have no offset to pack in the ICN records"""
+    return folding != "icn_rec" or wt_data_t not in CMixNNSignedDataPrecisions
+
+
+def CMixNNActivationsSupported(folding, *data_t):
+    """Signed activations are requantized with m/n scaling only"""
+    return folding in ("weights", "icn") or all(t in CMixNNDataPrecisions for t in data_t)
+
+
+def CMixNNQuantizedSupported(c):
+    """Quantization and folding of the output of a kernel"""
+    return CMixNNFoldingSupported(c['out_data_t'], c['quantization'], c['folding'])
+
+
+def CMixNNSignedSupported(c):
+    """Signed weights and activations of a kernel"""
+    return CMixNNWeightsSupported(c['wt_data_t'], c['folding']) and \
+        CMixNNActivationsSupported(c['folding'], *(c[k] for k in ('in_data_t', 'out_data_t') if k in c))
+
+
+def CMixNNGenerate(factory, src_dir, supported=lambda c: True, **loops):
+    """Writes a kernel of the factory for every combination of the loops (nested in the order they are
+    given) accepted by supported, and returns their API"""
+    api = ""
+    mkdir_p(src_dir)
+    for values in itertools.product(*loops.values()):
+        config = dict(zip(loops, values))
+        if supported(config):
+            c = factory(**config)
+            api += c.generate_api() + "\n"
+            new_file = open(src_dir + c.filename, 'w')
+            new_file.write(c.generate_code())
+            new_file.close()
+    return api
+
+
 CMixNNAPI = "\n"
 CMixNNSupportAPI = "\n"
 
@@ -32,11 +97,33 @@ class CMixNNFactory(object):
         self.in_data_t = in_data_t
         self.out_data_t = out_data_t
         self.wt_data_t = wt_data_t
+        self.wt_signed = wt_data_t in CMixNNSignedDataPrecisions
+        self.in_signed = in_data_t in CMixNNSignedDataPrecisions
+        self.out_signed = out_data_t in CMixNNSignedDataPrecisions
+        # type of the input and output offsets
+        self.z_in_t = "int8_t" if self.in_signed else "uint8_t"
+        self.z_out_t = "int8_t" if self.out_signed else "uint8_t"
+        self.raw = out_data_t in CMixNNRawPrecisions
+        self.out_ptr_t = out_data_t + "_t" if self.raw else "uint8_t"
         self.arithmetic_t = 'int16'
         self.fn_name = ''
         self.filename = ''
         self.quantization = ''
         self.folding = ''
+        self.dilated = False
+        self.grouped = False
+        self.transposed = False
+        self.first_layer = False
+        self.strided = False
+        self.windowed = False
+        self.partial = False
+        self.split_k = False
+        self.pool = False
+        self.sliced = False
+        self.residual = False
+        self.rows = False
+        self.fused = False
+        self.inverted_residual = False
         self.api = ''
         self.header_top = ''
         self.header_bottom = ''
@@ -45,13 +132,16 @@ class CMixNNFactory(object):
         return Template(filename="templates/arm_cmixnn_api.h").render(config=self)
 
 class CMixNNConvolve(CMixNNFactory):
-    def __init__(self, in_data_t, out_data_t, wt_data_t, quantization, folding):
+    def __init__(self, in_data_t, out_data_t, wt_data_t, quantization, folding, dilated=False, rows=False):
         super().__init__(in_data_t, out_data_t, wt_data_t)
-        self.fn_name = "arm_convolve_HWC_{0}_{1}_{2}{3}{4}".format(str(in_data_t), str(out_data_t), str(wt_data_t), str(
-            "_" + quantization if quantization != "PACT" else ""), str("_" + folding if folding != "weights" else ""))
+        self.fn_name = "arm_convolve{5}_HWC_{0}_{1}_{2}{3}{4}".format(str(in_data_t), str(out_data_t), str(wt_data_t), str(
+            "_" + quantization if quantization != "PACT" else ""), str("_" + folding if folding not in ("weights", "") else ""),
+            str("_dilated" if dilated else "_rows" if rows else ""))
         self.filename = self.fn_name + ".c"
         self.quantization = quantization
         self.folding = folding
+        self.dilated = dilated
+        self.rows = rows
         self.reordered_no_shift_load_fn = "arm_{0}_to_{1}_reordered".format(str(
             self.in_data_t), self.arithmetic_t)
         self.nn_mat_mul_fn = "arm_nn_mat_mult_kernel_reordered_{0}_{1}_{2}{3}{4}".format(str(wt_data_t),
@@ -59,8 +149,12 @@ class CMixNNConvolve(CMixNNFactory):
                                                                                          str(out_data_t), str(
                 "_" + quantization if quantization != "PACT" else ""), str(
                 "_" + folding if folding != "weights" else ""))
-        self.ch_in_constrain = CMixNNConstrains[in_data_t]
-        self.ch_out_constrain = CMixNNConstrains[out_data_t]
+        self.nn_mat_mul_strided_fn = CMixNNMatMul(out_data_t, wt_data_t, quantization, folding, strided=True).fn_name
+        self.nn_mat_mul_windowed_fn = CMixNNMatMul(out_data_t, wt_data_t, quantization, folding, windowed=True).fn_name
+        self.ch_in_vect = CMixNNConstrains[in_data_t]
+        self.wt_vect = CMixNNConstrains[wt_data_t]
+        self.ch_in_constrain = CMixNNChInConstrains[in_data_t]
+        self.ch_out_constrain = CMixNNChOutConstrains[out_data_t]
         self.api = self.__class__.__name__
 
     def generate_code(self):
@@ -69,14 +163,139 @@ class CMixNNConvolve(CMixNNFactory):
         return Template(filename="templates/arm_convolve_HWC_x_y_z.c").render(config=self)
 
 
-class CMixNNDepthwise(CMixNNFactory):
+class CMixNNConvolveGrouped(CMixNNConvolve):
     def __init__(self, in_data_t, out_data_t, wt_data_t, quantization, folding):
-        super().__init__(in_data_t, out_data_t, wt_data_t)
-        self.fn_name = "arm_depthwise_separable_conv_HWC_{0}_{1}_{2}{3}{4}".format(str(in_data_t), str(out_data_t), str(wt_data_t), str(
+        super().__init__(in_data_t, out_data_t, wt_data_t, quantization, folding)
+        self.fn_name = "arm_convolve_grouped_HWC_{0}_{1}_{2}{3}{4}".format(str(in_data_t), str(out_data_t), str(wt_data_t), str(
+            "_" + quantization if quantization != "PACT" else ""), str("_" + folding if folding != "weights" else ""))
+        self.filename = self.fn_name + ".c"
+        self.nn_mat_mul_fn = CMixNNMatMul(out_data_t, wt_data_t, quantization, folding, strided=True).fn_name
+        self.grouped = True
+        self.api = "CMixNNConvolve"
+
+    def generate_code(self):
+        self.header_top = Template(filename="templates/arm_cmixnn_header_top.h").render(config=self)
+        self.header_bottom = Template(filename="templates/arm_cmixnn_header_bottom.h").render(config=self)
+        return Template(filename="templates/arm_convolve_grouped_HWC_x_y_z.c").render(config=self)
+
+
+class CMixNNConvolveSliced(CMixNNConvolveGrouped):
+    def __init__(self, in_data_t, out_data_t, wt_data_t, quantization, folding):
+        super().__init__(in_data_t, out_data_t, wt_data_t, quantization, folding)
+        self.fn_name = "arm_convolve_sliced_HWC_{0}_{1}_{2}{3}{4}".format(str(in_data_t), str(out_data_t), str(wt_data_t), str(
+            "_" + quantization if quantization != "PACT" else ""), str("_" + folding if folding != "weights" else ""))
+        self.filename = self.fn_name + ".c"
+        self.ch_in_slice_constrain = CMixNNChInConstrains[in_data_t]
+        self.ch_out_slice_constrain = CMixNNChInConstrains[out_data_t]
+        self.grouped = False
+        self.sliced = True
+
+
+class CMixNNConvolveTransposed(CMixNNConvolve):
+    def __init__(self, in_data_t, out_data_t, wt_data_t, quantization, folding):
+        super().__init__(in_data_t, out_data_t, wt_data_t, quantization, folding)
+        self.fn_name = "arm_convolve_transposed_HWC_{0}_{1}_{2}{3}{4}".format(str(in_data_t), str(out_data_t), str(wt_data_t), str(
             "_" + quantization if quantization != "PACT" else ""), str("_" + folding if folding != "weights" else ""))
         self.filename = self.fn_name + ".c"
+        self.nn_mat_mul_fn = CMixNNMatMul(out_data_t, wt_data_t, quantization, folding, strided=True).fn_name
+        self.transposed = True
+        self.api = "CMixNNConvolve"
+
+    def generate_code(self):
+        self.header_top = Template(filename="templates/arm_cmixnn_header_top.h").render(config=self)
+        self.header_bottom = Template(filename="templates/arm_cmixnn_header_bottom.h").render(config=self)
+        return Template(filename="templates/arm_convolve_transposed_HWC_x_y_z.c").render(config=self)
+
+
+class CMixNNConvolveFirstLayer(CMixNNConvolve):
+    def __init__(self, in_data_t, out_data_t, wt_data_t, quantization, folding):
+        super().__init__(in_data_t, out_data_t, wt_data_t, quantization, folding)
+        self.fn_name = "arm_convolve_first_layer_HWC_{0}_{1}_{2}{3}{4}".format(str(in_data_t), str(out_data_t), str(wt_data_t), str(
+            "_" + quantization if quantization != "PACT" else ""), str("_" + folding if folding != "weights" else ""))
+        self.filename = self.fn_name + ".c"
+        self.first_layer = True
+        self.api = "CMixNNConvolve"
+
+    def generate_code(self):
+        self.header_top = Template(filename="templates/arm_cmixnn_header_top.h").render(config=self)
+        self.header_bottom = Template(filename="templates/arm_cmixnn_header_bottom.h").render(config=self)
+        return Template(filename="templates/arm_convolve_first_layer_HWC_x_y_z.c").render(config=self)
+
+
+class CMixNNConvolveSplitK(CMixNNConvolve):
+    def __init__(self, in_data_t, out_data_t, wt_data_t, quantization, folding):
+        super().__init__(in_data_t, out_data_t, wt_data_t, quantization, folding)
+        self.fn_name = "arm_convolve_split_k_HWC_{0}_{1}_{2}{3}{4}".format(str(in_data_t), str(out_data_t), str(wt_data_t), str(
+            "_" + quantization if quantization != "PACT" else ""), str("_" + folding if folding != "weights" else ""))
+        self.filename = self.fn_name + ".c"
+        self.nn_mat_mul_partial_fn = CMixNNMatMul('int32', wt_data_t, quantization, '', partial=True).fn_name
+        self.nn_mat_mul_partial_last_fn = CMixNNMatMul(out_data_t, wt_data_t, quantization, folding, partial=True).fn_name
+        self.ch_chunk_vect = max(CMixNNConstrains[in_data_t], CMixNNConstrains[wt_data_t])
+        self.split_k = True
+        self.api = "CMixNNConvolve"
+
+    def generate_code(self):
+        self.header_top = Template(filename="templates/arm_cmixnn_header_top.h").render(config=self)
+        self.header_bottom = Template(filename="templates/arm_cmixnn_header_bottom.h").render(config=self)
+        return Template(filename="templates/arm_convolve_split_k_HWC_x_y_z.c").render(config=self)
+
+
+class CMixNNConvolvePool(CMixNNConvolve):
+    def __init__(self, in_data_t, out_data_t, wt_data_t, quantization, folding):
+        super().__init__(in_data_t, out_data_t, wt_data_t, quantization, folding)
+        self.fn_name = "arm_convolve_pool_HWC_{0}_{1}_{2}{3}{4}".format(str(in_data_t), str(out_data_t), str(wt_data_t), str(
+            "_" + quantization if quantization != "PACT" else ""), str("_" + folding if folding != "weights" else ""))
+        self.filename = self.fn_name + ".c"
+        self.nn_mat_mul_partial_fn = CMixNNMatMul('int32', wt_data_t, quantization, '', partial=True).fn_name
+        self.pool = True
+        self.api = "CMixNNConvolve"
+
+    def generate_code(self):
+        self.header_top = Template(filename="templates/arm_cmixnn_header_top.h").render(config=self)
+        self.header_bottom = Template(filename="templates/arm_cmixnn_header_bottom.h").render(config=self)
+        return Template(filename="templates/arm_convolve_pool_HWC_x_y_z.c").render(config=self)
+
+
+class CMixNNConvolveResidual(CMixNNConvolve):
+    def __init__(self, in_data_t, res_data_t, out_data_t, wt_data_t, quantization, folding):
+        super().__init__(in_data_t, out_data_t, wt_data_t, quantization, folding)
+        self.fn_name = "arm_convolve_residual_HWC_{0}_{1}_{2}_{3}{4}{5}".format(str(in_data_t), str(res_data_t), str(out_data_t),
+            str(wt_data_t), str("_" + quantization if quantization != "PACT" else ""), str("_" + folding if folding != "weights" else ""))
+        self.filename = self.fn_name + ".c"
+        self.res_data_t = res_data_t
+        self.nn_mat_mul_partial_fn = CMixNNMatMul('int32', wt_data_t, quantization, '', partial=True).fn_name
+        self.residual = True
+        self.api = "CMixNNConvolve"
+
+    def generate_code(self):
+        self.header_top = Template(filename="templates/arm_cmixnn_header_top.h").render(config=self)
+        self.header_bottom = Template(filename="templates/arm_cmixnn_header_bottom.h").render(config=self)
+        return Template(filename="templates/arm_convolve_residual_HWC_x_y_z.c").render(config=self)
+
+
+class CMixNNConvolveRaw(CMixNNConvolve):
+    def __init__(self, in_data_t, out_data_t, wt_data_t, quantization):
+        super().__init__(in_data_t, out_data_t, wt_data_t, quantization, '')
+        self.nn_mat_mul_partial_fn = CMixNNMatMul('int32', wt_data_t, quantization, '', partial=True).fn_name
+        self.api = "CMixNNConvolve"
+
+    def generate_code(self):
+        self.header_top = Template(filename="templates/arm_cmixnn_header_top.h").render(config=self)
+        self.header_bottom = Template(filename="templates/arm_cmixnn_header_bottom.h").render(config=self)
+        return Template(filename="templates/arm_convolve_raw_HWC_x_y_z.c").render(config=self)
+
+
+class CMixNNDepthwise(CMixNNFactory):
+    def __init__(self, in_data_t, out_data_t, wt_data_t, quantization, folding, dilated=False, rows=False):
+        super().__init__(in_data_t, out_data_t, wt_data_t)
+        self.fn_name = "arm_depthwise_separable_conv{5}_HWC_{0}_{1}_{2}{3}{4}".format(str(in_data_t), str(out_data_t), str(wt_data_t), str(
+            "_" + quantization if quantization != "PACT" else ""), str("_" + folding if folding not in ("weights", "") else ""),
+            str("_dilated" if dilated else "_rows" if rows else ""))
+        self.filename = self.fn_name + ".c"
         self.quantization = quantization
         self.folding = folding
+        self.dilated = dilated
+        self.rows = rows
         self.api = self.__class__.__name__
 
     def generate_code(self):
@@ -85,17 +304,53 @@ class CMixNNDepthwise(CMixNNFactory):
         return Template(filename="templates/arm_depthwise_separable_conv_HWC_x_y_z.c").render(config=self)
 
 
+class CMixNNDepthwisePointwise(CMixNNDepthwise):
+    def __init__(self, in_data_t, mid_data_t, out_data_t, wt_data_t, quantization, folding):
+        super().__init__(in_data_t, mid_data_t, 'u8', quantization, folding)
+        self.fn_name = "arm_depthwise_pointwise_HWC_{0}_{1}_{2}_{3}{4}{5}".format(str(in_data_t), str(mid_data_t), str(out_data_t), str(wt_data_t), str(
+            "_" + quantization if quantization != "PACT" else ""), str("_" + folding if folding != "weights" else ""))
+        self.filename = self.fn_name + ".c"
+        self.pw_wt_data_t = wt_data_t
+        self.pw_out_data_t = out_data_t
+        self.reordered_no_shift_load_fn = "arm_{0}_to_{1}_reordered".format(str(mid_data_t), self.arithmetic_t)
+        self.nn_mat_mul_fn = CMixNNMatMul(out_data_t, wt_data_t, quantization, folding).fn_name
+        self.nn_mat_mul_strided_fn = CMixNNMatMul(out_data_t, wt_data_t, quantization, folding, strided=True).fn_name
+        self.ch_in_constrain = max(CMixNNChInConstrains[in_data_t], CMixNNChInConstrains[mid_data_t])
+        self.ch_out_constrain = CMixNNChOutConstrains[out_data_t]
+        self.fused = True
+        self.api = "CMixNNDepthwise"
+
+
+class CMixNNInvertedResidual(CMixNNDepthwisePointwise):
+    def __init__(self, in_data_t, mid_data_t, out_data_t, wt_data_t, quantization, folding):
+        super().__init__(mid_data_t, mid_data_t, out_data_t, wt_data_t, quantization, folding)
+        self.fn_name = "arm_inverted_residual_HWC_{0}_{1}_{2}_{3}{4}{5}".format(str(in_data_t), str(mid_data_t), str(out_data_t), str(wt_data_t), str(
+            "_" + quantization if quantization != "PACT" else ""), str("_" + folding if folding != "weights" else ""))
+        self.filename = self.fn_name + ".c"
+        self.ir_in_data_t = in_data_t
+        self.nn_mat_mul_partial_pw_fn = CMixNNMatMul('int32', wt_data_t, quantization, '', partial=True).fn_name
+        self.nn_mat_mul_ex_fn = CMixNNMatMul(mid_data_t, wt_data_t, quantization, folding).fn_name
+        self.nn_mat_mul_strided_ex_fn = CMixNNMatMul(mid_data_t, wt_data_t, quantization, folding, strided=True).fn_name
+        self.ch_in_constrain = CMixNNChInConstrains[in_data_t]
+        self.ch_ex_constrain = max(CMixNNChInConstrains[mid_data_t], CMixNNChOutConstrains[mid_data_t])
+        self.inverted_residual = True
+
+
 class CMixNNMatMul(CMixNNFactory):
-    def __init__(self, out_data_t, wt_data_t, quantization, folding):
+    def __init__(self, out_data_t, wt_data_t, quantization, folding, strided=False, windowed=False, partial=False):
         super().__init__("", out_data_t, wt_data_t)
-        self.fn_name = "arm_nn_mat_mult_kernel_reordered_{0}_{1}_{2}{3}{4}".format(str(wt_data_t),
+        self.fn_name = "arm_nn_mat_mult_kernel{5}_reordered_{0}_{1}_{2}{3}{4}".format(str(wt_data_t),
                                                                                    str(self.arithmetic_t),
                                                                                    str(out_data_t), str(
                 "_" + quantization if quantization != "PACT" else ""), str(
-                "_" + folding if folding != "weights" else ""))
+                "_" + folding if folding not in ("weights", "") else ""),
+                str("_partial" if partial else "_windowed" if windowed else "_strided" if strided else ""))
         self.filename = self.fn_name + ".c"
         self.quantization = quantization
         self.folding = folding
+        self.strided = strided or windowed or partial
+        self.windowed = windowed or partial
+        self.partial = partial
         self.api = self.__class__.__name__
 
     def generate_code(self):
@@ -104,6 +359,89 @@ class CMixNNMatMul(CMixNNFactory):
         return Template(filename="templates/arm_nn_mat_mult_kernel_reordered_x_y_z.c").render(config=self)
 
 
+class CMixNNParallel(CMixNNFactory):
+    def __init__(self):
+        super().__init__("", "", "")
+        self.fn_name = "arm_cmixnn_parallel_rows"
+        self.filename = self.fn_name + ".c"
+        self.api = self.__class__.__name__
+
+    def generate_code(self):
+        self.header_top = Template(filename="templates/arm_cmixnn_header_top.h").render(config=self)
+        self.header_bottom = Template(filename="templates/arm_cmixnn_header_bottom.h").render(config=self)
+        return Template(filename="templates/arm_cmixnn_parallel.c").render(config=self)
+
+
+class CMixNNPatch(CMixNNFactory):
+    def __init__(self):
+        super().__init__("", "", "")
+        self.fn_name = "arm_cmixnn_patch"
+        self.filename = self.fn_name + ".c"
+        self.api = self.__class__.__name__
+
+    def generate_code(self):
+        self.header_top = Template(filename="templates/arm_cmixnn_header_top.h").render(config=self)
+        self.header_bottom = Template(filename="templates/arm_cmixnn_header_bottom.h").render(config=self)
+        return Template(filename="templates/arm_cmixnn_patch.c").render(config=self)
+
+
+class CMixNNElementwise(CMixNNFactory):
+    def __init__(self, op, in_data_t, in2_data_t, out_data_t):
+        super().__init__(in_data_t, out_data_t, "")
+        self.fn_name = "arm_elementwise_{0}_{1}_{2}_{3}".format(str(op), str(in_data_t), str(in2_data_t), str(out_data_t))
+        self.filename = self.fn_name + ".c"
+        self.op = op
+        self.in2_data_t = in2_data_t
+        self.api = self.__class__.__name__
+
+    def generate_code(self):
+        self.header_top = Template(filename="templates/arm_cmixnn_header_top.h").render(config=self)
+        self.header_bottom = Template(filename="templates/arm_cmixnn_header_bottom.h").render(config=self)
+        return Template(filename="templates/arm_elementwise_x_y_z.c").render(config=self)
+
+
+class CMixNNRequantize(CMixNNFactory):
+    def __init__(self, in_data_t, out_data_t, folding):
+        super().__init__(in_data_t, out_data_t, "")
+        self.fn_name = "arm_requantize_{0}_to_{1}{2}".format(str(in_data_t), str(out_data_t), str(
+            "_" + folding if folding != "weights" else ""))
+        self.filename = self.fn_name + ".c"
+        self.folding = folding
+        self.api = self.__class__.__name__
+
+    def generate_code(self):
+        self.header_top = Template(filename="templates/arm_cmixnn_header_top.h").render(config=self)
+        self.header_bottom = Template(filename="templates/arm_cmixnn_header_bottom.h").render(config=self)
+        return Template(filename="templates/arm_requantize_x_to_y.c").render(config=self)
+
+
+class CMixNNSoftmax(CMixNNFactory):
+    def __init__(self, in_data_t):
+        super().__init__(in_data_t, "u8", "")
+        self.fn_name = "arm_softmax_{0}_{1}".format(str(in_data_t), str(self.out_data_t))
+        self.filename = self.fn_name + ".c"
+        self.api = self.__class__.__name__
+
+    def generate_code(self):
+        self.header_top = Template(filename="templates/arm_cmixnn_header_top.h").render(config=self)
+        self.header_bottom = Template(filename="templates/arm_cmixnn_header_bottom.h").render(config=self)
+        return Template(filename="templates/arm_softmax_x.c").render(config=self)
+
+
+class CMixNNTopK(CMixNNFactory):
+    def __init__(self, op, in_data_t):
+        super().__init__(in_data_t, "", "")
+        self.fn_name = "arm_{0}_{1}".format(str(op), str(in_data_t))
+        self.filename = self.fn_name + ".c"
+        self.op = op
+        self.api = self.__class__.__name__
+
+    def generate_code(self):
+        self.header_top = Template(filename="templates/arm_cmixnn_header_top.h").render(config=self)
+        self.header_bottom = Template(filename="templates/arm_cmixnn_header_bottom.h").render(config=self)
+        return Template(filename="templates/arm_topk_x.c").render(config=self)
+
+
 class CMixNNConvertReorder(CMixNNFactory):
     def __init__(self, in_data_t):
         super().__init__(in_data_t, "", "")
@@ -119,54 +457,143 @@ class CMixNNConvertReorder(CMixNNFactory):
 
 
 # Generate CMixNNConvolve
-mkdir_p(CMixNNSrcDirs['convolution'])
-for i in CMixNNDataPrecisions:
-    for j in CMixNNDataPrecisions:
-        for z in CMixNNDataPrecisions:
-            for q in CMixNNQuantizationMethods:
-                for f in CMixNNFoldingMethods:
-                    if (q == "PACT_CH" and f != "weights") or q == "PACT":
-                        c = CMixNNConvolve(in_data_t=i, out_data_t=j, wt_data_t=z, quantization=q, folding=f)
-                        CMixNNAPI += c.generate_api() + "\n"
-                        new_file = open(CMixNNSrcDirs['convolution'] + c.filename, 'w')
-                        new_file.write(c.generate_code())
-                        new_file.close()
+CMixNNAPI += CMixNNGenerate(CMixNNConvolve, CMixNNSrcDirs['convolution'],
+                            lambda c: CMixNNQuantizedSupported(c) and CMixNNSignedSupported(c),
+                            in_data_t=CMixNNActPrecisions, out_data_t=CMixNNActPrecisions, wt_data_t=CMixNNWtPrecisions,
+                            quantization=CMixNNQuantizationMethods, folding=CMixNNRecFoldingMethods)
+
+# Generate CMixNNConvolve (dilated)
+CMixNNAPI += CMixNNGenerate(partial(CMixNNConvolve, dilated=True), CMixNNSrcDirs['convolution'], CMixNNQuantizedSupported,
+                            in_data_t=CMixNNDataPrecisions, out_data_t=CMixNNDataPrecisions, wt_data_t=CMixNNDataPrecisions,
+                            quantization=CMixNNQuantizationMethods, folding=CMixNNFoldingMethods)
+
+# Generate CMixNNConvolve (output row range)
+CMixNNAPI += CMixNNGenerate(partial(CMixNNConvolve, rows=True), CMixNNSrcDirs['convolution'], CMixNNQuantizedSupported,
+                            in_data_t=CMixNNDataPrecisions, out_data_t=CMixNNDataPrecisions, wt_data_t=CMixNNDataPrecisions,
+                            quantization=CMixNNQuantizationMethods, folding=CMixNNFoldingMethods)
+
+# Generate CMixNNConvolveGrouped
+CMixNNAPI += CMixNNGenerate(CMixNNConvolveGrouped, CMixNNSrcDirs['convolution'], CMixNNQuantizedSupported,
+                            in_data_t=CMixNNDataPrecisions, out_data_t=CMixNNDataPrecisions, wt_data_t=CMixNNDataPrecisions,
+                            quantization=CMixNNQuantizationMethods, folding=CMixNNFoldingMethods)
+
+# Generate CMixNNConvolveSliced
+CMixNNAPI += CMixNNGenerate(CMixNNConvolveSliced, CMixNNSrcDirs['convolution'], CMixNNQuantizedSupported,
+                            in_data_t=CMixNNDataPrecisions, out_data_t=CMixNNDataPrecisions, wt_data_t=CMixNNDataPrecisions,
+                            quantization=CMixNNQuantizationMethods, folding=CMixNNFoldingMethods)
+
+# Generate CMixNNConvolveTransposed
+CMixNNAPI += CMixNNGenerate(CMixNNConvolveTransposed, CMixNNSrcDirs['convolution'], CMixNNQuantizedSupported,
+                            in_data_t=CMixNNDataPrecisions, out_data_t=CMixNNDataPrecisions, wt_data_t=CMixNNDataPrecisions,
+                            quantization=CMixNNQuantizationMethods, folding=CMixNNFoldingMethods)
+
+# Generate CMixNNConvolveFirstLayer (u8 input only)
+CMixNNAPI += CMixNNGenerate(CMixNNConvolveFirstLayer, CMixNNSrcDirs['convolution'], CMixNNQuantizedSupported,
+                            in_data_t=['u8'], out_data_t=CMixNNDataPrecisions, wt_data_t=CMixNNDataPrecisions,
+                            quantization=CMixNNQuantizationMethods, folding=CMixNNFoldingMethods)
+
+# Generate CMixNNConvolveSplitK
+CMixNNAPI += CMixNNGenerate(CMixNNConvolveSplitK, CMixNNSrcDirs['convolution'], CMixNNQuantizedSupported,
+                            in_data_t=CMixNNDataPrecisions, out_data_t=CMixNNDataPrecisions, wt_data_t=CMixNNDataPrecisions,
+                            quantization=CMixNNQuantizationMethods, folding=CMixNNFoldingMethods)
+
+# Generate CMixNNConvolvePool
+CMixNNAPI += CMixNNGenerate(CMixNNConvolvePool, CMixNNSrcDirs['convolution'], CMixNNQuantizedSupported,
+                            in_data_t=CMixNNDataPrecisions, out_data_t=CMixNNDataPrecisions, wt_data_t=CMixNNDataPrecisions,
+                            quantization=CMixNNQuantizationMethods, folding=CMixNNFoldingMethods)
+
+# Generate CMixNNConvolveResidual
+CMixNNAPI += CMixNNGenerate(CMixNNConvolveResidual, CMixNNSrcDirs['convolution'], CMixNNQuantizedSupported,
+                            in_data_t=CMixNNDataPrecisions, res_data_t=CMixNNDataPrecisions, out_data_t=CMixNNDataPrecisions,
+                            wt_data_t=CMixNNDataPrecisions, quantization=CMixNNQuantizationMethods, folding=CMixNNFoldingMethods)
+
+# Generate CMixNNConvolveRaw (raw accumulator output)
+CMixNNAPI += CMixNNGenerate(CMixNNConvolveRaw, CMixNNSrcDirs['convolution'],
+                            in_data_t=CMixNNActPrecisions, out_data_t=CMixNNRawPrecisions, wt_data_t=CMixNNDataPrecisions,
+                            quantization=CMixNNQuantizationMethods)
 
 # Generate CMixNNDepthwise
-mkdir_p(CMixNNSrcDirs['convolution'])
-for i in CMixNNDataPrecisions:
-    for j in CMixNNDataPrecisions:
-        for z in CMixNNDataPrecisions:
-            for q in CMixNNQuantizationMethods:
-                for f in CMixNNFoldingMethods:
-                    if (q == "PACT_CH" and f != "weights") or q == "PACT":
-                        c = CMixNNDepthwise(in_data_t=i, out_data_t=j, wt_data_t=z, quantization=q, folding=f)
-                        CMixNNAPI += c.generate_api() + "\n"
-                        new_file = open(CMixNNSrcDirs['convolution'] + c.filename, 'w')
-                        new_file.write(c.generate_code())
-                        new_file.close()
+CMixNNAPI += CMixNNGenerate(CMixNNDepthwise, CMixNNSrcDirs['convolution'],
+                            lambda c: CMixNNQuantizedSupported(c) and CMixNNSignedSupported(c),
+                            in_data_t=CMixNNActPrecisions, out_data_t=CMixNNActPrecisions, wt_data_t=CMixNNDataPrecisions,
+                            quantization=CMixNNQuantizationMethods, folding=CMixNNPow2FoldingMethods)
+
+# Generate CMixNNDepthwise (raw accumulator output)
+CMixNNAPI += CMixNNGenerate(partial(CMixNNDepthwise, folding=''), CMixNNSrcDirs['convolution'],
+                            in_data_t=CMixNNActPrecisions, out_data_t=CMixNNRawPrecisions, wt_data_t=CMixNNDataPrecisions,
+                            quantization=CMixNNQuantizationMethods)
+
+# Generate CMixNNDepthwise (dilated)
+CMixNNAPI += CMixNNGenerate(partial(CMixNNDepthwise, dilated=True), CMixNNSrcDirs['convolution'], CMixNNQuantizedSupported,
+                            in_data_t=CMixNNDataPrecisions, out_data_t=CMixNNDataPrecisions, wt_data_t=CMixNNDataPrecisions,
+                            quantization=CMixNNQuantizationMethods, folding=CMixNNFoldingMethods)
+
+# Generate CMixNNDepthwise (output row range)
+CMixNNAPI += CMixNNGenerate(partial(CMixNNDepthwise, rows=True), CMixNNSrcDirs['convolution'], CMixNNQuantizedSupported,
+                            in_data_t=CMixNNDataPrecisions, out_data_t=CMixNNDataPrecisions, wt_data_t=CMixNNDataPrecisions,
+                            quantization=CMixNNQuantizationMethods, folding=CMixNNFoldingMethods)
+
+# Generate CMixNNDepthwisePointwise (u8 depthwise weights)
+CMixNNAPI += CMixNNGenerate(CMixNNDepthwisePointwise, CMixNNSrcDirs['convolution'],
+                            lambda c: CMixNNQuantizedSupported(c) and CMixNNFoldingSupported(c['mid_data_t'], c['quantization'], c['folding']),
+                            in_data_t=CMixNNDataPrecisions, mid_data_t=CMixNNDataPrecisions, out_data_t=CMixNNDataPrecisions,
+                            wt_data_t=CMixNNDataPrecisions, quantization=CMixNNQuantizationMethods, folding=CMixNNFoldingMethods)
+
+# Generate CMixNNInvertedResidual (u8 depthwise weights, expanded and depthwise output tensors at mid precision)
+CMixNNAPI += CMixNNGenerate(CMixNNInvertedResidual, CMixNNSrcDirs['convolution'],
+                            lambda c: CMixNNQuantizedSupported(c) and CMixNNFoldingSupported(c['mid_data_t'], c['quantization'], c['folding']),
+                            in_data_t=CMixNNDataPrecisions, mid_data_t=CMixNNDataPrecisions, out_data_t=CMixNNDataPrecisions,
+                            wt_data_t=CMixNNDataPrecisions, quantization=CMixNNQuantizationMethods, folding=CMixNNFoldingMethods)
 
 # Generate CMixNNMatMul
-mkdir_p(CMixNNSrcDirs['convolution'])
-for i in CMixNNDataPrecisions:
-    for j in CMixNNDataPrecisions:
-        for q in CMixNNQuantizationMethods:
-            for f in CMixNNFoldingMethods:
-                if (q == "PACT_CH" and f != "weights") or q == "PACT":
-                    c = CMixNNMatMul(out_data_t=i, wt_data_t=j, quantization=q, folding=f)
-                    CMixNNAPI += c.generate_api() + "\n"
-                    new_file = open(CMixNNSrcDirs['convolution'] + c.filename, 'w')
-                    new_file.write(c.generate_code())
-                    new_file.close()
+CMixNNAPI += CMixNNGenerate(CMixNNMatMul, CMixNNSrcDirs['convolution'],
+                            lambda c: CMixNNQuantizedSupported(c) and CMixNNSignedSupported(c),
+                            out_data_t=CMixNNActPrecisions, wt_data_t=CMixNNWtPrecisions,
+                            quantization=CMixNNQuantizationMethods, folding=CMixNNRecFoldingMethods)
+
+# Generate CMixNNMatMul (strided output)
+CMixNNAPI += CMixNNGenerate(partial(CMixNNMatMul, strided=True), CMixNNSrcDirs['convolution'],
+                            lambda c: CMixNNQuantizedSupported(c) and CMixNNSignedSupported(c),
+                            out_data_t=CMixNNActPrecisions, wt_data_t=CMixNNWtPrecisions,
+                            quantization=CMixNNQuantizationMethods, folding=CMixNNRecFoldingMethods)
+
+# Generate CMixNNMatMul (windowed weights, strided output)
+CMixNNAPI += CMixNNGenerate(partial(CMixNNMatMul, windowed=True), CMixNNSrcDirs['convolution'],
+                            lambda c: CMixNNQuantizedSupported(c) and CMixNNSignedSupported(c),
+                            out_data_t=CMixNNActPrecisions, wt_data_t=CMixNNWtPrecisions,
+                            quantization=CMixNNQuantizationMethods, folding=CMixNNRecFoldingMethods)
+
+# Generate CMixNNMatMul (partial sums of a split-K convolution: int32 sums with no folding, then the last chunk)
+CMixNNAPI += CMixNNGenerate(partial(CMixNNMatMul, partial=True), CMixNNSrcDirs['convolution'],
+                            lambda c: c['folding'] == '' if c['out_data_t'] == 'int32' else
+                            c['folding'] != '' and CMixNNQuantizedSupported(c),
+                            wt_data_t=CMixNNDataPrecisions, out_data_t=['int32'] + CMixNNDataPrecisions,
+                            quantization=CMixNNQuantizationMethods, folding=[''] + CMixNNFoldingMethods)
+
+# Generate CMixNNElementwise
+CMixNNAPI += CMixNNGenerate(CMixNNElementwise, CMixNNSrcDirs['BasicMath'],
+                            op=['add', 'mul'], in_data_t=CMixNNDataPrecisions, in2_data_t=CMixNNDataPrecisions,
+                            out_data_t=CMixNNDataPrecisions)
+
+# Generate CMixNNSoftmax
+CMixNNAPI += CMixNNGenerate(CMixNNSoftmax, CMixNNSrcDirs['Softmax'], in_data_t=CMixNNSoftmaxPrecisions)
+
+# Generate CMixNNTopK (argmax and top-k of packed logits)
+CMixNNAPI += CMixNNGenerate(CMixNNTopK, CMixNNSrcDirs['Softmax'], op=['argmax', 'topk'], in_data_t=CMixNNDataPrecisions)
 
 # Generate CMixNNConvertReorder
-mkdir_p(CMixNNSrcDirs['NNSupport'])
-for i in CMixNNDataPrecisions:
-    c = CMixNNConvertReorder(in_data_t=i)
-    CMixNNSupportAPI += c.generate_api() + "\n"
-    new_file = open(CMixNNSrcDirs['NNSupport'] + c.filename, 'w')
-    new_file.write(c.generate_code())
-    new_file.close()
+CMixNNSupportAPI += CMixNNGenerate(CMixNNConvertReorder, CMixNNSrcDirs['NNSupport'], in_data_t=CMixNNActPrecisions)
+
+# Generate CMixNNRequantize (thresholds only to u4/u2)
+CMixNNSupportAPI += CMixNNGenerate(CMixNNRequantize, CMixNNSrcDirs['NNSupport'],
+                                   lambda c: c['folding'] != "thr" or c['out_data_t'] != "u8",
+                                   in_data_t=CMixNNDataPrecisions, out_data_t=CMixNNDataPrecisions, folding=['weights', 'thr'])
+
+# Generate CMixNNParallel
+CMixNNSupportAPI += CMixNNGenerate(CMixNNParallel, CMixNNSrcDirs['NNSupport'])
+
+# Generate CMixNNPatch
+CMixNNSupportAPI += CMixNNGenerate(CMixNNPatch, CMixNNSrcDirs['NNSupport'])
 
 # Generate new include files
 mkdir_p(CMixNNSrcDirs['Include'])
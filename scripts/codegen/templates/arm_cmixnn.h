@@ -89,6 +89,13 @@ extern    "C"
  * 
  */
 
+/**
+ * @defgroup CMIXBasicMath CMix-NN Basic Math Functions
+ *
+ * Element-wise addition and multiplication of packed tensors.
+ *
+ */
+
 /**
  * @defgroup CMIXPool CMix-NN Pooling Functions
  *
@@ -99,8 +106,8 @@ extern    "C"
 /**
  * @defgroup CMIXSoftmax CMix-NN Softmax Functions
  *
- * To be completed.
- * 
+ * Integer softmax of u8, u4 and int32 logits, and argmax and top-k of packed logits.
+ *
  */
 #ifdef __cplusplus
 }
@@ -1,6 +1,28 @@
 % if config.api=="CMixNNConvolve":
   /**
+% if config.dilated:
+   * @brief Mixed Precision Dilated Convolution ${config.folding} (in: ${config.in_data_t}, out: ${config.out_data_t}, wt: ${config.wt_data_t})
+% elif config.sliced:
+   * @brief Mixed Precision Sliced Convolution ${config.folding} (in: ${config.in_data_t}, out: ${config.out_data_t}, wt: ${config.wt_data_t})
+% elif config.grouped:
+   * @brief Mixed Precision Grouped Convolution ${config.folding} (in: ${config.in_data_t}, out: ${config.out_data_t}, wt: ${config.wt_data_t})
+% elif config.transposed:
+   * @brief Mixed Precision Transposed Convolution ${config.folding} (in: ${config.in_data_t}, out: ${config.out_data_t}, wt: ${config.wt_data_t})
+% elif config.pool:
+   * @brief Mixed Precision Convolution with 2x2 Pooling ${config.folding} (in: ${config.in_data_t}, out: ${config.out_data_t}, wt: ${config.wt_data_t})
+% elif config.residual:
+   * @brief Mixed Precision Convolution with Residual Add ${config.folding} (in: ${config.in_data_t}, res: ${config.res_data_t}, out: ${config.out_data_t}, wt: ${config.wt_data_t})
+% elif config.split_k:
+   * @brief Mixed Precision Split-K Convolution ${config.folding} (in: ${config.in_data_t}, out: ${config.out_data_t}, wt: ${config.wt_data_t})
+% elif config.rows:
+   * @brief Mixed Precision Row Range Convolution ${config.folding} (in: ${config.in_data_t}, out: ${config.out_data_t}, wt: ${config.wt_data_t})
+% elif config.first_layer:
+   * @brief Mixed Precision First Layer Convolution ${config.folding} (in: ${config.in_data_t}, out: ${config.out_data_t}, wt: ${config.wt_data_t})
+% elif config.raw:
+   * @brief Mixed Precision Convolution with raw ${config.out_data_t} output (in: ${config.in_data_t}, wt: ${config.wt_data_t})
+% else:
    * @brief Mixed Precision Convolution ${config.folding} (in: ${config.in_data_t}, out: ${config.out_data_t}, wt: ${config.wt_data_t})
+% endif
    *
    * @param[in]       Im_in       pointer to input tensor
    * @param[in]       dim_im_in   input tensor dimension
@@ -13,140 +35,340 @@
    * @param[in]       top_pad     padding sizes
    * @param[in]       bottom_pad  padding sizes
    * @param[in]       stride      convolution stride
+% if config.dilated:
+   * @param[in]       dilation    kernel dilation factor
+% endif
+% if config.rows:
+   * @param[in]       out_y_begin first output row to compute
+   * @param[in]       out_y_end   output row following the last one to compute
+% endif
+% if config.grouped:
+   * @param[in]       groups      number of groups, each one convolving ch_im_in/groups input channels
+% endif
+% if config.sliced:
+   * @param[in]       in_ch_offset  first input channel read, in each pixel of Im_in
+   * @param[in]       in_pix_stride number of channels of an Im_in pixel
+   * @param[in]       out_ch_offset first output channel written, in each pixel of Im_out
+   * @param[in]       out_pix_stride number of channels of an Im_out pixel
+% endif
+% if config.split_k:
+   * @param[in]       bufferA_size  number of int16_t elements available in bufferA
+% endif
+% if config.pool:
+   * @param[in]       pool        CMIXNN_MAX_POOL or CMIXNN_AVG_POOL, 2x2 window and stride 2
+% endif
+% if config.folding=="icn_rec":
+   * @param[in]       ch_params   pointer to the requantization records of the output channels (bias, m_zero, n_zero, z_wt)
+% else:
    * @param[in]       bias        pointer to bias
+% endif
+% if config.residual:
+   * @param[in]       Im_res      pointer to residual tensor, same shape as the output
+% endif
+% if config.pool:
+   * @param[in,out]   Im_out      pointer to pooled output tensor, dim_im_out/2 x dim_im_out/2
+   * @param[in]       dim_im_out  convolution output tensor dimension
+% else:
    * @param[in,out]   Im_out      pointer to output tensor
    * @param[in]       dim_im_out  output tensor dimension
+% endif
    * @param[in]       z_in        input offset
-% if config.quantization=="PACT":
+% if config.quantization=="PACT" and not config.wt_signed:
    * @param[in]       z_wt        weights offset
-% elif config.quantization=="PACT_CH":
+% elif config.quantization=="PACT_CH" and config.folding!="icn_rec" and not config.wt_signed:
    * @param[in]       *z_wt       weights offset, per-output channel
 % endif
-% if config.folding=="thr":
+% if config.raw:
+%   if config.out_data_t == 'int16':
+   * @param[in]       n_zero      right shift of the accumulators, 0 to 31
+%   endif
+% elif config.folding=="thr":
    * @param[in]       thresholds  pointer to thresholds
 % elif config.folding=="icn":
    * @param[in]       z_out       output offset
    * @param[in]       *m_zero     pointer to m zero quantization params (per-output-ch)
    * @param[in]       *n_zero     pointer to n zero quantization params (per-output-ch)
+% elif config.folding=="icn_rec":
+   * @param[in]       z_out       output offset
+% elif config.folding=="pow2":
+   * @param[in]       z_out       output offset
+   * @param[in]       n_zero      right shift of the power-of-two scale, 0 to 31
 % else:
    * @param[in]       z_out       output offset
    * @param[in]       m_zero      m zero quantization param
    * @param[in]       n_zero      n zero quantization param
+% endif
+% if config.residual:
+   * @param[in]       z_res       residual offset
+   * @param[in]       m_res       residual m quantization param
+   * @param[in]       n_res       residual n quantization param
 % endif
    * @param[in,out]   bufferA     pointer to buffer space for input
+% if config.first_layer:
+   * @param[in,out]   bufferB     pointer to buffer space for one padded kernel row, dim_kernel*ch_im_in uint8_t
+% elif config.split_k:
+   * @param[in,out]   bufferB     pointer to buffer space for the partial sums, 2*ch_im_out int32_t (32-bit aligned)
+% elif config.pool:
+   * @param[in,out]   bufferB     pointer to buffer space for the sums of a pooling window, 4*ch_im_out int32_t (32-bit aligned)
+% elif config.residual or config.raw:
+   * @param[in,out]   bufferB     pointer to buffer space for the sums of a pixel pair, 2*ch_im_out int32_t (32-bit aligned)
+% else:
    * @param[in,out]   bufferB     pointer to buffer space for output
+% endif
    * @return     The function returns either
    * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
    */
 
 arm_status
 ${config.fn_name}(const uint8_t * Im_in,
-                        const uint16_t dim_im_in,
-                        const uint16_t ch_im_in,
+                        const cmixnn_dim_t dim_im_in,
+                        const cmixnn_dim_t ch_im_in,
                         const uint8_t * wt,
-                        const uint16_t ch_im_out,
-                        const uint16_t dim_kernel,
+                        const cmixnn_dim_t ch_im_out,
+                        const cmixnn_dim_t dim_kernel,
                         const uint8_t left_padding,
                         const uint8_t right_padding,
                         const uint8_t top_padding,
                         const uint8_t bottom_padding,
-                        const uint16_t stride,
+                        const cmixnn_dim_t stride,
+% if config.dilated:
+                        const cmixnn_dim_t dilation,
+% endif
+% if config.rows:
+                        const cmixnn_dim_t out_y_begin,
+                        const cmixnn_dim_t out_y_end,
+% endif
+% if config.grouped:
+                        const cmixnn_dim_t groups,
+% endif
+% if config.sliced:
+                        const cmixnn_dim_t in_ch_offset,
+                        const cmixnn_dim_t in_pix_stride,
+                        const cmixnn_dim_t out_ch_offset,
+                        const cmixnn_dim_t out_pix_stride,
+% endif
+% if config.split_k:
+                        const cmixnn_dim_t bufferA_size,
+% endif
+% if config.pool:
+                        const cmixnn_pool_t pool,
+% endif
+% if config.folding=="icn_rec":
+                        const cmixnn_icn_rec_t * ch_params,
+% else:
                         const int32_t * bias,
-                        uint8_t * Im_out,
-                        const uint16_t dim_im_out,
-                        const uint8_t z_in,
-% if config.quantization=="PACT":
+% endif
+% if config.residual:
+                        const uint8_t * Im_res,
+% endif
+                        ${config.out_ptr_t} * Im_out,
+                        const cmixnn_dim_t dim_im_out,
+                        const ${config.z_in_t} z_in,
+% if config.quantization=="PACT" and not config.wt_signed:
                         const uint8_t z_wt,
-% elif config.quantization=="PACT_CH":
+% elif config.quantization=="PACT_CH" and config.folding!="icn_rec" and not config.wt_signed:
                         const uint8_t *z_wt,
 % endif
-% if config.folding=="thr":
+% if config.raw:
+%   if config.out_data_t == 'int16':
+                        const int8_t n_zero,
+%   endif
+% elif config.folding=="thr":
                         const int16_t * thresholds,
 % elif config.folding=="icn":
-                        const uint8_t z_out,
+                        const ${config.z_out_t} z_out,
                         const int32_t *m_zero,
                         const int8_t *n_zero,
+% elif config.folding=="icn_rec":
+                        const ${config.z_out_t} z_out,
+% elif config.folding=="pow2":
+                        const ${config.z_out_t} z_out,
+                        const int8_t n_zero,
 % else:
-                        const uint8_t z_out,
+                        const ${config.z_out_t} z_out,
                         const int32_t m_zero,
                         const int8_t n_zero,
+% endif
+% if config.residual:
+                        const uint8_t z_res,
+                        const int32_t m_res,
+                        const int8_t n_res,
 % endif
                         int16_t * bufferA,
                         uint8_t * bufferB);
 % elif config.api=="CMixNNMatMul":
  /**
    * @brief Matrix-Multiplication function for ${config.wt_data_t} x int16_t convolution with reordered columns.
+% if config.out_data_t == 'int32':
+   *        Output is accumulated into int32_t partial sums.
+% else:
    *        Output is then quantized to ${config.out_data_t} using ${config.folding} config.folding technique.
+% endif
    * @param[in]       pA          pointer to operand A
    * @param[in]       pInBuffer   pointer to operand B, always consists of 2 vectors
    * @param[in]       ch_im_out   numRow of A
    * @param[in]       numCol_A    numCol of A
+% if config.windowed:
+   * @param[in]       seg_len     columns of A read contiguously, a multiple of 32-bit words of A unless equal to numCol_A
+   * @param[in]       seg_stride  columns of A between the beginning of two consecutive segments
+   * @param[in]       row_len     columns of A between two consecutive rows
+% endif
+% if config.partial:
+   * @param[in,out]   pSum        partial sums of the two output pixels (2*ch_im_out, pixel by pixel), bias included
+% elif config.folding=="icn_rec":
+   * @param[in]       ch_params   pointer to the requantization records of the output channels (bias, m_zero, n_zero, z_wt)
+% else:
    * @param[in]       bias        the bias
+% endif
+% if config.out_data_t != 'int32':
    * @param[in,out]   pOut        pointer to output
+% endif
+% if config.strided and config.out_data_t != 'int32':
+   * @param[in]       ch_out_stride  number of channels between two consecutive output pixels
+% endif
+% if config.quantization=="PACT" and not config.wt_signed:
    * @param[in]       z_a         A operand offset
-% if config.quantization=="PACT":
-   * @param[in]       z_a         A operand offset
-% elif config.quantization=="PACT_CH":
+% elif config.quantization=="PACT_CH" and config.folding!="icn_rec" and not config.wt_signed:
    * @param[in]       *z_a        pointer to A operand offsets (per-output channel)
 % endif
-% if config.folding=="thr":
+% if config.out_data_t == 'int32':
+% elif config.folding=="thr":
    * @param[in]       thresholds  pointer to thresholds for quantization
 % elif config.folding=="icn":
    * @param[in]       z_out       output offset
    * @param[in]       m_zero      pointer to m zero quantization params (per-output-ch)
    * @param[in]       n_zero      pointer to n zero quantization params (per-output-ch)
+% elif config.folding=="icn_rec":
+   * @param[in]       z_out       output offset
+% elif config.folding=="pow2":
+   * @param[in]       z_out       output offset
+   * @param[in]       n_zero      right shift of the power-of-two scale, 0 to 31
 % else:
    * @param[in]       z_out       output offset
    * @param[in]       m_zero      m zero quantization param
    * @param[in]       n_zero      n zero quantization param
 % endif
+% if config.out_data_t == 'int32':
+   * @return none.
+% else:
    * @return     The function returns the incremented output pointer
+% endif
    *
    * @details
    *
    * This function assumes that data in pInBuffer are reordered
    */
 
+% if config.out_data_t == 'int32':
+void
+% else:
 uint8_t *
+% endif
 ${config.fn_name}(const uint8_t * pA,
                         const int16_t * pInBuffer,
-                        const uint16_t ch_im_out,
-                        const uint16_t numCol_A,
+                        const cmixnn_dim_t ch_im_out,
+                        const cmixnn_dim_t numCol_A,
+% if config.windowed:
+                        const cmixnn_dim_t seg_len,
+                        const cmixnn_dim_t seg_stride,
+                        const cmixnn_dim_t row_len,
+% endif
+% if config.partial:
+                        int32_t * pSum,
+% elif config.folding=="icn_rec":
+                        const cmixnn_icn_rec_t * ch_params,
+% else:
                         const int32_t * bias,
+% endif
+% if config.out_data_t == 'int32':
+%   if config.quantization=="PACT":
+                        const uint8_t z_a);
+%   elif config.quantization=="PACT_CH":
+                        const uint8_t *z_a);
+%   endif
+% else:
                         uint8_t * pOut,
-% if config.quantization=="PACT":
+% endif
+% if config.strided and config.out_data_t != 'int32':
+                        const cmixnn_dim_t ch_out_stride,
+% endif
+% if config.out_data_t == 'int32':
+% elif config.quantization=="PACT" and not config.wt_signed:
                         const uint8_t z_a,
-% elif config.quantization=="PACT_CH":
+% elif config.quantization=="PACT_CH" and config.folding!="icn_rec" and not config.wt_signed:
                         const uint8_t *z_a,
 % endif
-% if config.folding=="thr":
+% if config.out_data_t == 'int32':
+% elif config.folding=="thr":
                         const int16_t * thresholds);
 % elif config.folding=="icn":
-                        const uint8_t z_out,
+                        const ${config.z_out_t} z_out,
                         const int32_t *m_zero,
                         const int8_t *n_zero);
+% elif config.folding=="icn_rec":
+                        const ${config.z_out_t} z_out);
+% elif config.folding=="pow2":
+                        const ${config.z_out_t} z_out,
+                        const int8_t n_zero);
 % else:
-                        const uint8_t z_out,
+                        const ${config.z_out_t} z_out,
                         const int32_t m_zero,
                         const int8_t n_zero);
 % endif
 % elif config.api=="CMixNNDepthwise":
 /**
+% if config.dilated:
+   * @brief Mixed Precision Dilated Depthwise Convolutional function that uses ${config.in_data_t} activations, ${config.wt_data_t} weights
+% elif config.rows:
+   * @brief Mixed Precision Row Range Depthwise Convolutional function that uses ${config.in_data_t} activations, ${config.wt_data_t} weights
+% elif config.inverted_residual:
+   * @brief Mixed Precision fused Inverted Residual function that uses ${config.ir_in_data_t} activations, ${config.pw_wt_data_t} expansion and
+   *        projection weights, ${config.wt_data_t} depthwise weights, ${config.out_data_t} intermediate activations
+% elif config.fused:
+   * @brief Mixed Precision fused Depthwise and Pointwise Convolutional function that uses ${config.in_data_t} activations,
+   *        ${config.wt_data_t} depthwise weights, ${config.out_data_t} intermediate activations, ${config.pw_wt_data_t} pointwise weights
+% else:
    * @brief Mixed Precision Depthwise Convolutional function that uses ${config.in_data_t} activations, ${config.wt_data_t} weights
-   *        and produce ${config.in_data_t} output activations. Outputs are quantized using ${config.folding} folding technique.
+% endif
+% if config.fused:
+   *        and produce ${config.pw_out_data_t} output activations. Outputs are quantized using ${config.folding} folding technique.
+% elif config.raw:
+   *        and produce the raw ${config.out_data_t} accumulators, with no requantization.
+% else:
+   *        and produce ${config.out_data_t} output activations. Outputs are quantized using ${config.folding} folding technique.
+% endif
    *
    * @param[in]       Im_in       pointer to input tensor
    * @param[in]       dim_im_in   input tensor dimension
    * @param[in]       ch_im_in    number of input tensor channels
+% if config.inverted_residual:
+   * @param[in]       wt_ex       pointer to expansion kernel weights
+   * @param[in]       ch_im_ex    number of expansion filters, i.e., expanded channels
+   * @param[in]       bias_ex     pointer to expansion bias
+   * @param[in]       wt          pointer to depthwise kernel weights
+% else:
    * @param[in]       wt          pointer to kernel weights
    * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+% endif
    * @param[in]       dim_kernel  filter kernel size
    * @param[in]       left_pad    padding sizes
    * @param[in]       right_pad   padding sizes
    * @param[in]       top_pad     padding sizes
    * @param[in]       bottom_pad  padding sizes
    * @param[in]       stride      convolution stride
+% if config.dilated:
+   * @param[in]       dilation    kernel dilation factor
+% endif
+% if config.rows:
+   * @param[in]       out_y_begin first output row to compute
+   * @param[in]       out_y_end   output row following the last one to compute
+% endif
    * @param[in]       bias        pointer to bias
+% if config.fused:
+   * @param[in]       wt_pw       pointer to pointwise kernel weights
+   * @param[in]       ch_im_out_pw number of pointwise filters, i.e., output tensor channels
+   * @param[in]       bias_pw     pointer to pointwise bias
+% endif
    * @param[in,out]   Im_out      pointer to output tensor
    * @param[in]       dim_im_out  output tensor dimension
    * @param[in]       z_in        input offset
@@ -155,57 +377,344 @@ ${config.fn_name}(const uint8_t * pA,
 % elif config.quantization=="PACT_CH":
    * @param[in]       *z_wt       weights offset, per-output channel
 % endif
-% if config.folding=="thr":
+% if config.raw:
+%   if config.out_data_t == 'int16':
+   * @param[in]       n_zero      right shift of the accumulators, 0 to 31
+%   endif
+% elif config.folding=="thr":
    * @param[in]       thresholds  pointer to thresholds
+%   if config.fused:
+   * @param[in]       z_out       offset of the thresholded intermediate activations
+%   endif
 % elif config.folding=="icn":
    * @param[in]       z_out       output offset
    * @param[in]       m_zero      pointer to m zero quantization params (per-output-ch)
    * @param[in]       n_zero      pointer to n zero quantization params (per-output-ch)
+% elif config.folding=="pow2":
+   * @param[in]       z_out       output offset
+   * @param[in]       n_zero      right shift of the power-of-two scale, 0 to 31
 % else:
    * @param[in]       z_out       output offset
    * @param[in]       m_zero      m zero quantization param
    * @param[in]       n_zero      n zero quantization param
 % endif
+% if config.inverted_residual:
+%   if config.quantization=="PACT":
+   * @param[in]       z_wt_ex     expansion weights offset
+%   elif config.quantization=="PACT_CH":
+   * @param[in]       *z_wt_ex    expansion weights offset, per-output channel
+%   endif
+%   if config.folding=="thr":
+   * @param[in]       thresholds_ex pointer to expansion thresholds
+   * @param[in]       z_out_ex    offset of the thresholded expanded activations
+%   elif config.folding=="icn":
+   * @param[in]       z_out_ex    expansion output offset
+   * @param[in]       m_zero_ex   pointer to expansion m zero quantization params (per-output-ch)
+   * @param[in]       n_zero_ex   pointer to expansion n zero quantization params (per-output-ch)
+%   else:
+   * @param[in]       z_out_ex    expansion output offset
+   * @param[in]       m_zero_ex   expansion m zero quantization param
+   * @param[in]       n_zero_ex   expansion n zero quantization param
+%   endif
+% endif
+% if config.fused:
+%   if config.quantization=="PACT":
+   * @param[in]       z_wt_pw     pointwise weights offset
+%   elif config.quantization=="PACT_CH":
+   * @param[in]       *z_wt_pw    pointwise weights offset, per-output channel
+%   endif
+%   if config.folding=="thr":
+   * @param[in]       thresholds_pw pointer to pointwise thresholds
+%   elif config.folding=="icn":
+   * @param[in]       z_out_pw    pointwise output offset
+   * @param[in]       m_zero_pw   pointer to pointwise m zero quantization params (per-output-ch)
+   * @param[in]       n_zero_pw   pointer to pointwise n zero quantization params (per-output-ch)
+%   else:
+   * @param[in]       z_out_pw    pointwise output offset
+   * @param[in]       m_zero_pw   pointwise m zero quantization param
+   * @param[in]       n_zero_pw   pointwise n zero quantization param
+%   endif
+%   if config.inverted_residual:
+   * @param[in]       m_res       residual m quantization param, 0 for no residual add
+   * @param[in]       n_res       residual n quantization param
+   * @param[in,out]   bufferA     pointer to buffer space for input, max(dim_kernel * dim_kernel * ch_im_ex, 4 * ch_im_ex, 4 * ch_im_in) bytes
+   * @param[in,out]   bufferB     pointer to buffer space for dim_kernel rows of the expanded tensor, a row of the depthwise output and 2 * ch_im_out_pw int32_t (32-bit aligned)
+%   else:
+   * @param[in,out]   bufferA     pointer to buffer space for input, max(dim_kernel * dim_kernel * ch_im_in, 4 * ch_im_in) bytes
+   * @param[in,out]   bufferB     pointer to buffer space for a row of the depthwise output
+%   endif
+% else:
    * @param[in,out]   bufferA     pointer to buffer space for input
    * @param[in,out]   bufferB     pointer to buffer space for output
+% endif
    * @return     The function returns either
    * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
    */
 
 arm_status
 ${config.fn_name}(const uint8_t * Im_in,
-                        const uint16_t dim_im_in,
-                        const uint16_t ch_im_in,
+                        const cmixnn_dim_t dim_im_in,
+                        const cmixnn_dim_t ch_im_in,
+% if config.inverted_residual:
+                        const uint8_t * wt_ex,
+                        const cmixnn_dim_t ch_im_ex,
+                        const int32_t * bias_ex,
                         const uint8_t * wt,
-                        const uint16_t ch_im_out,
-                        const uint16_t dim_kernel,
+% else:
+                        const uint8_t * wt,
+                        const cmixnn_dim_t ch_im_out,
+% endif
+                        const cmixnn_dim_t dim_kernel,
                         const uint8_t left_padding,
                         const uint8_t right_padding,
                         const uint8_t top_padding,
                         const uint8_t bottom_padding,
-                        const uint16_t stride,
+                        const cmixnn_dim_t stride,
+% if config.dilated:
+                        const cmixnn_dim_t dilation,
+% endif
+% if config.rows:
+                        const cmixnn_dim_t out_y_begin,
+                        const cmixnn_dim_t out_y_end,
+% endif
                         const int32_t * bias,
-                        uint8_t * Im_out,
-                        const uint16_t dim_im_out,
-                        const uint8_t z_in,
+% if config.fused:
+                        const uint8_t * wt_pw,
+                        const cmixnn_dim_t ch_im_out_pw,
+                        const int32_t * bias_pw,
+% endif
+                        ${config.out_ptr_t} * Im_out,
+                        const cmixnn_dim_t dim_im_out,
+                        const ${config.z_in_t} z_in,
+% if config.inverted_residual:
+%   if config.quantization=="PACT":
+                        const uint8_t z_wt_ex,
+%   elif config.quantization=="PACT_CH":
+                        const uint8_t *z_wt_ex,
+%   endif
+%   if config.folding=="thr":
+                        const int16_t * thresholds_ex,
+                        const uint8_t z_out_ex,
+%   else:
+                        const uint8_t z_out_ex,
+%     if config.folding=="icn":
+                        const int32_t *m_zero_ex,
+                        const int8_t *n_zero_ex,
+%     else:
+                        const int32_t m_zero_ex,
+                        const int8_t n_zero_ex,
+%     endif
+%   endif
+% endif
 % if config.quantization=="PACT":
                         const uint8_t z_wt,
 % elif config.quantization=="PACT_CH":
                         const uint8_t *z_wt,
 % endif
-% if config.folding=="thr":
+% if config.raw:
+%   if config.out_data_t == 'int16':
+                        const int8_t n_zero,
+%   endif
+% elif config.folding=="thr":
                         const int16_t * thresholds,
+%   if config.fused:
+                        const ${config.z_out_t} z_out,
+%   endif
 % elif config.folding=="icn":
-                        const uint8_t z_out,
+                        const ${config.z_out_t} z_out,
                         const int32_t *m_zero,
                         const int8_t *n_zero,
+% elif config.folding=="pow2":
+                        const ${config.z_out_t} z_out,
+                        const int8_t n_zero,
 % else:
-                        const uint8_t z_out,
+                        const ${config.z_out_t} z_out,
                         const int32_t m_zero,
                         const int8_t n_zero,
+% endif
+% if config.fused:
+%   if config.quantization=="PACT":
+                        const uint8_t z_wt_pw,
+%   elif config.quantization=="PACT_CH":
+                        const uint8_t *z_wt_pw,
+%   endif
+%   if config.folding=="thr":
+                        const int16_t * thresholds_pw,
+%   else:
+                        const uint8_t z_out_pw,
+%     if config.folding=="icn":
+                        const int32_t *m_zero_pw,
+                        const int8_t *n_zero_pw,
+%     else:
+                        const int32_t m_zero_pw,
+                        const int8_t n_zero_pw,
+%     endif
+%   endif
+% endif
+% if config.inverted_residual:
+                        const int32_t m_res,
+                        const int8_t n_res,
 % endif
                         int16_t * bufferA,
                         uint8_t * bufferB);
+% elif config.api=="CMixNNParallel":
+/**
+ * @brief Splits the output rows of a layer in n_workers contiguous ranges and computes them
+ *        concurrently (fork-join).
+ * @param[in] fn          job computing a row range
+ * @param[in] args        arguments of the layer, passed to every job
+ * @param[in] dim_im_out  output tensor dimension
+ * @param[in] n_workers   number of workers, at most CMIXNN_MAX_WORKERS
+ * @return none.
+ */
+
+void
+${config.fn_name}(cmixnn_rows_fn_t fn,
+                        void *args,
+                        const cmixnn_dim_t dim_im_out,
+                        const uint16_t n_workers);
+% elif config.api=="CMixNNPatch":
+/**
+ * @brief Computes the memory and the MACs of a patch-based execution of a chain of layers,
+ *        against the layer-by-layer execution.
+ * @param[in]  layers      chain of layers, the output of each one is the input of the next one
+ * @param[in]  n_layers    number of layers, at most CMIXNN_MAX_PATCH_LAYERS
+ * @param[in]  dim_im_in   input tensor dimension of the first layer
+ * @param[in]  n_patches   number of patches per side of the last output
+ * @param[out] plan        sizes and MACs of the execution
+ * @return     The function returns either
+ * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+ */
+
+arm_status
+${config.fn_name}_plan(const cmixnn_patch_layer_t *layers,
+                        const uint16_t n_layers,
+                        const cmixnn_dim_t dim_im_in,
+                        const uint16_t n_patches,
+                        cmixnn_patch_plan_t *plan);
+
+/**
+ * @brief Runs a chain of layers patch by patch, so only the intermediate tensors of one
+ *        patch are stored.
+ * @param[in]       layers      chain of layers, the output of each one is the input of the next one
+ * @param[in]       n_layers    number of layers, at most CMIXNN_MAX_PATCH_LAYERS
+ * @param[in]       Im_in       pointer to input tensor of the first layer
+ * @param[in]       dim_im_in   input tensor dimension of the first layer
+ * @param[in,out]   Im_out      pointer to output tensor of the last layer
+ * @param[in]       n_patches   number of patches per side of the last output
+ * @param[in,out]   bufferA     pointer to buffer space for a patch, plan->buffer_size bytes
+ * @param[in,out]   bufferB     pointer to buffer space for a patch, plan->buffer_size bytes
+ * @return     The function returns either
+ * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+ */
+
+arm_status
+${config.fn_name}_execute(const cmixnn_patch_layer_t *layers,
+                        const uint16_t n_layers,
+                        const uint8_t *Im_in,
+                        const cmixnn_dim_t dim_im_in,
+                        uint8_t *Im_out,
+                        const uint16_t n_patches,
+                        uint8_t *bufferA,
+                        uint8_t *bufferB);
+% elif config.api=="CMixNNElementwise":
+  /**
+   * @brief Mixed Precision element-wise ${"addition" if config.op == "add" else "multiplication"} (a: ${config.in_data_t}, b: ${config.in2_data_t}, out: ${config.out_data_t})
+   *
+   * @param[in]       pA          pointer to the first input tensor
+   * @param[in]       pB          pointer to the second input tensor
+   * @param[in,out]   pOut        pointer to the output tensor
+   * @param[in]       size        number of elements
+   * @param[in]       z_a         first input offset
+% if config.op == "add":
+   * @param[in]       m_a         first input m quantization param
+   * @param[in]       n_a         first input n quantization param
+   * @param[in]       z_b         second input offset
+   * @param[in]       m_b         second input m quantization param
+   * @param[in]       n_b         second input n quantization param
+   * @param[in]       z_out       output offset
+% else:
+   * @param[in]       z_b         second input offset
+   * @param[in]       z_out       output offset
+   * @param[in]       m_zero      m zero quantization param
+   * @param[in]       n_zero      n zero quantization param
+% endif
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   */
+
+arm_status
+${config.fn_name}(const uint8_t * pA,
+                        const uint8_t * pB,
+                        uint8_t * pOut,
+                        const cmixnn_dim_t size,
+                        const uint8_t z_a,
+% if config.op == "add":
+                        const int32_t m_a,
+                        const int8_t n_a,
+                        const uint8_t z_b,
+                        const int32_t m_b,
+                        const int8_t n_b,
+                        const uint8_t z_out);
+% else:
+                        const uint8_t z_b,
+                        const uint8_t z_out,
+                        const int32_t m_zero,
+                        const int8_t n_zero);
+% endif
+% elif config.api=="CMixNNSoftmax":
+  /**
+   * @brief Integer softmax (in: ${config.in_data_t}, out: ${config.out_data_t})
+   *
+   * @param[in]       pSrc        pointer to the logits
+   * @param[in,out]   pOut        pointer to the u8 probabilities, 1/256 units
+   * @param[in]       size        number of logits, at most 131071
+   * @param[in]       m_zero      m quantization param of the exponent
+   * @param[in]       n_zero      n quantization param of the exponent
+   * @return     The function returns either
+   * <code>ARM_MATH_ARGUMENT_ERROR</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   */
+
+arm_status
+${config.fn_name}(const ${"int32_t" if config.in_data_t == "int32" else "uint8_t"} * pSrc,
+                        uint8_t * pOut,
+                        const cmixnn_dim_t size,
+                        const int32_t m_zero,
+                        const int8_t n_zero);
+% elif config.api=="CMixNNTopK":
+  /**
+% if config.op == "argmax":
+   * @brief Argmax of packed logits (in: ${config.in_data_t})
+% else:
+   * @brief Top-k of packed logits (in: ${config.in_data_t})
+% endif
+   *
+   * @param[in]       pSrc        pointer to the packed logits
+   * @param[in]       size        number of logits
+% if config.op == "argmax":
+   * @param[out]      pMax        maximum logit
+   * @param[out]      pIndex      index of the maximum logit, the lowest one on a tie
+% else:
+   * @param[in]       k           number of logits to select, 1 to size
+   * @param[out]      pVal        k best logits, in decreasing order
+   * @param[out]      pIndex      k indices of the best logits, the lowest ones first on a tie
+% endif
+   * @return     The function returns either
+   * <code>ARM_MATH_ARGUMENT_ERROR</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   */
+
+arm_status
+% if config.op == "argmax":
+${config.fn_name}(const uint8_t * pSrc,
+                        const cmixnn_dim_t size,
+                        uint8_t * pMax,
+                        cmixnn_dim_t * pIndex);
+% else:
+${config.fn_name}(const uint8_t * pSrc,
+                        const cmixnn_dim_t size,
+                        const cmixnn_dim_t k,
+                        uint8_t * pVal,
+                        cmixnn_dim_t * pIndex);
+% endif
 % elif config.api=="CMixNNConvertReorder":
 /**
  * @brief Converts the elements of ${config.in_data_t} vector to
@@ -222,5 +731,35 @@ ${config.fn_name}(
                         const uint8_t *pSrc,
                         int16_t *pDst,
                         uint32_t blockSize,
-                        const uint8_t offset);
+                        const ${config.z_in_t} offset);
+% elif config.api=="CMixNNRequantize":
+/**
+ * @brief Requantizes the elements of a ${config.in_data_t} tensor to a ${config.out_data_t} tensor (${config.folding}).
+ * @param[in] *pSrc       points to the ${config.in_data_t} input tensor
+ * @param[out] *pDst      points to the ${config.out_data_t} output tensor
+ * @param[in] size        number of elements
+ * @param[in] z_in        input quantization offset
+% if config.folding == "thr":
+ * @param[in] thresholds  pointer to the thresholds applied to the input minus z_in
+% else:
+ * @param[in] z_out       output quantization offset
+ * @param[in] m_zero      m zero quantization param
+ * @param[in] n_zero      n zero quantization param
+% endif
+ * @return none.
+ */
+
+void
+${config.fn_name}(
+                        const uint8_t *pSrc,
+                        uint8_t *pDst,
+                        uint32_t size,
+                        const uint8_t z_in,
+% if config.folding == "thr":
+                        const int16_t *thresholds);
+% else:
+                        const uint8_t z_out,
+                        const int32_t m_zero,
+                        const int8_t n_zero);
+% endif
 % endif
@@ -0,0 +1,111 @@
+${config.header_top}
+ * Description:  Fork-join driver computing the output rows of a layer
+ *               on several workers.
+ ${config.header_bottom}
+
+#include "arm_cmixnn.h"
+
+#if defined(CMIXNN_PTHREAD)
+#include <pthread.h>
+
+static void *arm_cmixnn_pthread_worker(void *arg)
+{
+    const cmixnn_job_t *job = (const cmixnn_job_t *) arg;
+
+    job->fn(job->args, job->out_y_begin, job->out_y_end, job->worker);
+    return NULL;
+}
+#endif
+
+/**
+ * @ingroup groupSupport
+ */
+
+/**
+ * @addtogroup CMixNN_parallel
+ * @{
+ */
+
+/**
+ * @brief Splits the output rows of a layer in n_workers contiguous ranges and computes them
+ *        concurrently. Worker 0 runs on the calling core, the others are forked and joined
+ *        before returning.
+ * @param[in] fn          job computing a row range, usually a call to a *_rows_* kernel
+ *                        with the bufferA of the worker
+ * @param[in] args        arguments of the layer, passed to every job
+ * @param[in] dim_im_out  output tensor dimension
+ * @param[in] n_workers   number of workers, at most CMIXNN_MAX_WORKERS
+ * @return none.
+ *
+ * @details
+ *
+ * With CMIXNN_PTHREAD defined the workers are POSIX threads: the rows of a thread that
+ * cannot be created are computed on the calling core, after those of worker 0. Otherwise
+ * the application provides arm_cmixnn_fork(), which starts job->fn on another core and
+ * returns, and arm_cmixnn_join(), which waits for the end of that job.
+ */
+
+void
+${config.fn_name}(cmixnn_rows_fn_t fn,
+                        void *args,
+                        const cmixnn_dim_t dim_im_out,
+                        const uint16_t n_workers)
+{
+    cmixnn_job_t jobs[CMIXNN_MAX_WORKERS];
+#if defined(CMIXNN_PTHREAD)
+    pthread_t threads[CMIXNN_MAX_WORKERS];
+    uint8_t started[CMIXNN_MAX_WORKERS];
+#endif
+    uint16_t n = (n_workers > CMIXNN_MAX_WORKERS) ? CMIXNN_MAX_WORKERS : n_workers;
+    uint16_t w;
+
+    /* at least one row per worker */
+    n = (n > dim_im_out) ? dim_im_out : n;
+    if (n == 0)
+    {
+        return;
+    }
+
+    for (w = 0; w < n; w++)
+    {
+        jobs[w].fn = fn;
+        jobs[w].args = args;
+        jobs[w].out_y_begin = (int32_t) w * dim_im_out / n;
+        jobs[w].out_y_end = (int32_t) (w + 1) * dim_im_out / n;
+        jobs[w].worker = w;
+    }
+
+    /* fork */
+    for (w = 1; w < n; w++)
+    {
+#if defined(CMIXNN_PTHREAD)
+        started[w] = (pthread_create(&threads[w], NULL, arm_cmixnn_pthread_worker, &jobs[w]) == 0);
+#else
+        arm_cmixnn_fork(&jobs[w]);
+#endif
+    }
+
+    fn(args, jobs[0].out_y_begin, jobs[0].out_y_end, 0);
+
+    /* join */
+    for (w = 1; w < n; w++)
+    {
+#if defined(CMIXNN_PTHREAD)
+        if (started[w])
+        {
+            pthread_join(threads[w], NULL);
+        }
+        else
+        {
+            /* the thread could not be created: compute its rows on the calling core */
+            fn(args, jobs[w].out_y_begin, jobs[w].out_y_end, jobs[w].worker);
+        }
+#else
+        arm_cmixnn_join(&jobs[w]);
+#endif
+    }
+}
+
+/**
+ * @} end of CMixNN_parallel group
+ */
@@ -0,0 +1,283 @@
+${config.header_top}
+ * Description:  Patch-based executor running a chain of layers on square
+ *               spatial patches with halo, so that only the intermediate
+ *               tensors of one patch are live at a time.
+ ${config.header_bottom}
+
+#include "arm_cmixnn.h"
+
+/**
+ * @ingroup groupSupport
+ */
+
+/**
+ * @addtogroup CMixNN_patch
+ * @{
+ */
+
+/* bytes of one packed pixel */
+static uint32_t arm_cmixnn_patch_pixel_bytes(cmixnn_dim_t ch, uint8_t bits)
+{
+    return ((uint32_t) ch * bits) >> 3;
+}
+
+/* byte holding the padding of a layer in every packed element: the depthwise kernels pad with
+   the raw value 0, the other kernels with the input offset */
+static uint8_t arm_cmixnn_patch_fill_byte(const cmixnn_patch_layer_t *layer, uint8_t bits)
+{
+    const uint8_t z = layer->depthwise ? 0 : layer->z_in;
+
+    if (bits == 4)
+    {
+        return (z & 0x0F) * 0x11;
+    }
+    else if (bits == 2)
+    {
+        return (z & 0x03) * 0x55;
+    }
+    return z;
+}
+
+/* tensor dimension, patch size and patch origin of every stage (stage 0 is the input of the chain) */
+static arm_status arm_cmixnn_patch_geometry(const cmixnn_patch_layer_t *layers,
+                                            const uint16_t n_layers,
+                                            const cmixnn_dim_t dim_im_in,
+                                            const uint16_t n_patches,
+                                            int32_t *dim,
+                                            int32_t *size)
+{
+    uint16_t l;
+
+    if (n_layers == 0 || n_layers > CMIXNN_MAX_PATCH_LAYERS || n_patches == 0)
+    {
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    dim[0] = dim_im_in;
+    for (l = 0; l < n_layers; l++)
+    {
+        const int32_t dim_kernel_dil = (layers[l].dim_kernel - 1) * layers[l].dilation + 1;
+
+        if (dim[l] + 2 * layers[l].padding < dim_kernel_dil || layers[l].stride == 0)
+        {
+            return ARM_MATH_SIZE_MISMATCH;
+        }
+        /* packed pixels fill whole bytes, so that patches are cropped with byte copies */
+        if ((((uint32_t) layers[l].ch_im_in * layers[l].in_bits) & 0x7) != 0
+            || (((uint32_t) layers[l].ch_im_out * layers[l].out_bits) & 0x7) != 0)
+        {
+            return ARM_MATH_SIZE_MISMATCH;
+        }
+        dim[l + 1] = (dim[l] + 2 * layers[l].padding - dim_kernel_dil) / layers[l].stride + 1;
+    }
+
+    /* square patches of the last output, the last row/column of patches is shifted inside the tensor */
+    size[n_layers] = (dim[n_layers] + n_patches - 1) / n_patches;
+    for (l = n_layers; l > 0; l--)
+    {
+        size[l - 1] = (size[l] - 1) * layers[l - 1].stride + (layers[l - 1].dim_kernel - 1) * layers[l - 1].dilation + 1;
+    }
+
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @brief Computes the memory and the MACs of a patch-based execution of a chain of layers,
+ *        against the layer-by-layer execution.
+ * @param[in]  layers      chain of layers, the output of each one is the input of the next one
+ * @param[in]  n_layers    number of layers, at most CMIXNN_MAX_PATCH_LAYERS
+ * @param[in]  dim_im_in   input tensor dimension of the first layer
+ * @param[in]  n_patches   number of patches per side of the last output
+ * @param[out] plan        sizes and MACs of the execution
+ * @return     The function returns either
+ * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+ */
+
+arm_status
+${config.fn_name}_plan(const cmixnn_patch_layer_t *layers,
+                        const uint16_t n_layers,
+                        const cmixnn_dim_t dim_im_in,
+                        const uint16_t n_patches,
+                        cmixnn_patch_plan_t *plan)
+{
+    int32_t dim[CMIXNN_MAX_PATCH_LAYERS + 1];
+    int32_t size[CMIXNN_MAX_PATCH_LAYERS + 1];
+    uint16_t l;
+
+    if (arm_cmixnn_patch_geometry(layers, n_layers, dim_im_in, n_patches, dim, size) != ARM_MATH_SUCCESS)
+    {
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    plan->buffer_size = (uint32_t) size[0] * size[0] * arm_cmixnn_patch_pixel_bytes(layers[0].ch_im_in, layers[0].in_bits);
+    plan->layer_peak_memory = 0;
+    plan->macs = 0;
+    plan->layer_macs = 0;
+
+    for (l = 0; l < n_layers; l++)
+    {
+        const uint32_t in_bytes = arm_cmixnn_patch_pixel_bytes(layers[l].ch_im_in, layers[l].in_bits);
+        const uint32_t out_bytes = arm_cmixnn_patch_pixel_bytes(layers[l].ch_im_out, layers[l].out_bits);
+        const uint64_t macs_per_pixel = (uint64_t) layers[l].dim_kernel * layers[l].dim_kernel * layers[l].ch_im_in
+                                        * (layers[l].depthwise ? 1 : layers[l].ch_im_out);
+        const uint32_t layer_memory = (uint32_t) dim[l] * dim[l] * in_bytes + (uint32_t) dim[l + 1] * dim[l + 1] * out_bytes;
+        const uint32_t patch_out = (uint32_t) size[l + 1] * size[l + 1] * out_bytes;
+
+        plan->buffer_size = (patch_out > plan->buffer_size) ? patch_out : plan->buffer_size;
+        plan->layer_peak_memory = (layer_memory > plan->layer_peak_memory) ? layer_memory : plan->layer_peak_memory;
+        plan->macs += (uint64_t) n_patches * n_patches * size[l + 1] * size[l + 1] * macs_per_pixel;
+        plan->layer_macs += (uint64_t) dim[l + 1] * dim[l + 1] * macs_per_pixel;
+    }
+
+    /* input and output tensors of the chain plus the two patch buffers */
+    plan->peak_memory = (uint32_t) dim[0] * dim[0] * arm_cmixnn_patch_pixel_bytes(layers[0].ch_im_in, layers[0].in_bits)
+                        + (uint32_t) dim[n_layers] * dim[n_layers]
+                          * arm_cmixnn_patch_pixel_bytes(layers[n_layers - 1].ch_im_out, layers[n_layers - 1].out_bits)
+                        + 2 * plan->buffer_size;
+
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @brief Runs a chain of layers patch by patch. The last output is split in n_patches x n_patches
+ *        square patches; for every patch, each layer is computed on the region (with halo) needed
+ *        by the next one, so only the intermediate tensors of one patch are stored.
+ * @param[in]       layers      chain of layers, the output of each one is the input of the next one
+ * @param[in]       n_layers    number of layers, at most CMIXNN_MAX_PATCH_LAYERS
+ * @param[in]       Im_in       pointer to input tensor of the first layer
+ * @param[in]       dim_im_in   input tensor dimension of the first layer
+ * @param[in,out]   Im_out      pointer to output tensor of the last layer
+ * @param[in]       n_patches   number of patches per side of the last output
+ * @param[in,out]   bufferA     pointer to buffer space for a patch, plan->buffer_size bytes
+ * @param[in,out]   bufferB     pointer to buffer space for a patch, plan->buffer_size bytes
+ * @return     The function returns either
+ * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+ *
+ * @details
+ *
+ * Every layer is run by its fn with no padding on a square patch: the padding of the layer is
+ * stored in the patch as it would be by its kernel, i.e. as input offsets (z_in), or as raw zeros
+ * for depthwise layers. The number of channels of every tensor must fill whole bytes. The patches of the last row and column are shifted
+ * inside the output, so a few output pixels may be computed twice.
+ */
+
+arm_status
+${config.fn_name}_execute(const cmixnn_patch_layer_t *layers,
+                        const uint16_t n_layers,
+                        const uint8_t *Im_in,
+                        const cmixnn_dim_t dim_im_in,
+                        uint8_t *Im_out,
+                        const uint16_t n_patches,
+                        uint8_t *bufferA,
+                        uint8_t *bufferB)
+{
+    int32_t dim[CMIXNN_MAX_PATCH_LAYERS + 1];
+    int32_t size[CMIXNN_MAX_PATCH_LAYERS + 1];
+    int32_t org_y[CMIXNN_MAX_PATCH_LAYERS + 1];
+    int32_t org_x[CMIXNN_MAX_PATCH_LAYERS + 1];
+    uint16_t p_y, p_x, l;
+    int32_t y, x;
+
+    if (arm_cmixnn_patch_geometry(layers, n_layers, dim_im_in, n_patches, dim, size) != ARM_MATH_SUCCESS)
+    {
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    for (p_y = 0; p_y < n_patches; p_y++)
+    {
+        for (p_x = 0; p_x < n_patches; p_x++)
+        {
+            uint8_t *pIn = bufferA;
+            uint8_t *pOut = bufferB;
+
+            /* origin of the patch in every stage, from the last output back to the input */
+            org_y[n_layers] = (p_y * size[n_layers] + size[n_layers] > dim[n_layers]) ? dim[n_layers] - size[n_layers] : p_y * size[n_layers];
+            org_x[n_layers] = (p_x * size[n_layers] + size[n_layers] > dim[n_layers]) ? dim[n_layers] - size[n_layers] : p_x * size[n_layers];
+            for (l = n_layers; l > 0; l--)
+            {
+                org_y[l - 1] = org_y[l] * layers[l - 1].stride - layers[l - 1].padding;
+                org_x[l - 1] = org_x[l] * layers[l - 1].stride - layers[l - 1].padding;
+            }
+
+            /* crop the input patch, the padding holds the input offset */
+            {
+                const uint32_t px = arm_cmixnn_patch_pixel_bytes(layers[0].ch_im_in, layers[0].in_bits);
+                const uint8_t fill = arm_cmixnn_patch_fill_byte(&layers[0], layers[0].in_bits);
+
+                for (y = 0; y < size[0]; y++)
+                {
+                    const int32_t i_y = org_y[0] + y;
+                    uint8_t *pRow = pIn + y * size[0] * px;
+
+                    for (x = 0; x < size[0]; x++)
+                    {
+                        const int32_t i_x = org_x[0] + x;
+
+                        if (i_y < 0 || i_y >= dim[0] || i_x < 0 || i_x >= dim[0])
+                        {
+                            memset(pRow + x * px, fill, px);
+                        }
+                        else
+                        {
+                            memcpy(pRow + x * px, Im_in + (i_y * dim[0] + i_x) * px, px);
+                        }
+                    }
+                }
+            }
+
+            for (l = 0; l < n_layers; l++)
+            {
+                uint8_t *pTmp;
+
+                if (layers[l].fn(pIn, size[l], pOut, size[l + 1], layers[l].args) != ARM_MATH_SUCCESS)
+                {
+                    return ARM_MATH_SIZE_MISMATCH;
+                }
+
+                if (l + 1 < n_layers)
+                {
+                    /* pixels outside the tensor are the padding of the next layer */
+                    const uint32_t px = arm_cmixnn_patch_pixel_bytes(layers[l].ch_im_out, layers[l].out_bits);
+                    const uint8_t fill = arm_cmixnn_patch_fill_byte(&layers[l + 1], layers[l].out_bits);
+
+                    for (y = 0; y < size[l + 1]; y++)
+                    {
+                        const int32_t i_y = org_y[l + 1] + y;
+
+                        for (x = 0; x < size[l + 1]; x++)
+                        {
+                            const int32_t i_x = org_x[l + 1] + x;
+
+                            if (i_y < 0 || i_y >= dim[l + 1] || i_x < 0 || i_x >= dim[l + 1])
+                            {
+                                memset(pOut + (y * size[l + 1] + x) * px, fill, px);
+                            }
+                        }
+                    }
+                }
+
+                pTmp = pIn;
+                pIn = pOut;
+                pOut = pTmp;
+            }
+
+            /* store the output patch */
+            {
+                const uint32_t px = arm_cmixnn_patch_pixel_bytes(layers[n_layers - 1].ch_im_out, layers[n_layers - 1].out_bits);
+
+                for (y = 0; y < size[n_layers]; y++)
+                {
+                    memcpy(Im_out + ((org_y[n_layers] + y) * dim[n_layers] + org_x[n_layers]) * px,
+                           pIn + y * size[n_layers] * px,
+                           size[n_layers] * px);
+                }
+            }
+        }
+    }
+
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMixNN_patch group
+ */
@@ -55,6 +55,116 @@ extern "C"
                  /**< Q7 type */
   };
 
+  /**
+   * @brief Types of tensor dimensions and of the signed indices computed from them.
+   *        16-bit by default; define CMIXNN_LARGE_TENSORS to build every kernel with
+   *        32-bit dimensions and index arithmetic (e.g. large feature maps on Cortex-A
+   *        or host simulation, or more than 65535 columns per filter).
+   */
+#ifdef CMIXNN_LARGE_TENSORS
+  typedef int32_t cmixnn_dim_t;
+  typedef int32_t cmixnn_idx_t;
+#else
+  typedef uint16_t cmixnn_dim_t;
+  typedef int16_t cmixnn_idx_t;
+#endif
+
+  /**
+   * @brief Reduction of the fused pooling of arm_convolve_pool_HWC_*()
+   */
+  typedef enum
+  {
+      CMIXNN_MAX_POOL = 0,
+      CMIXNN_AVG_POOL = 1
+  } cmixnn_pool_t;
+
+  /**
+   * @brief Requantization record of an output channel of the *_PACT_CH_icn_rec kernels (16 bytes).
+   *        The shifts are the n_zero normalization done offline, z_wt is repeated in both halfwords
+   *        for the SIMD subtraction. Keep the arrays 8-byte aligned so that bias and m_zero load
+   *        with a single LDRD.
+   */
+  typedef struct
+  {
+      int32_t bias;       /**< bias of the output channel */
+      int32_t m_zero;     /**< m zero quantization param */
+      int32_t z_wt;       /**< weights offset, in both halfwords */
+      int8_t n_zero1;     /**< left shift, -n_zero if n_zero <= 0 else 0 */
+      int8_t n_zero2;     /**< right shift, n_zero if n_zero > 0 else 0 */
+      int16_t reserved;
+  } cmixnn_icn_rec_t;
+
+#ifndef CMIXNN_MAX_WORKERS
+#define CMIXNN_MAX_WORKERS 8
+#endif
+
+  /**
+   * @brief Job of a worker of arm_cmixnn_parallel_rows(): computes the output rows
+   *        [out_y_begin, out_y_end) of the layer described by args.
+   */
+  typedef void (*cmixnn_rows_fn_t)(void *args, cmixnn_dim_t out_y_begin, cmixnn_dim_t out_y_end, uint16_t worker);
+
+  typedef struct
+  {
+      cmixnn_rows_fn_t fn;
+      void *args;
+      cmixnn_dim_t out_y_begin;
+      cmixnn_dim_t out_y_end;
+      uint16_t worker;
+  } cmixnn_job_t;
+
+#if !defined(CMIXNN_PTHREAD)
+  /**
+   * @brief Fork-join hooks provided by the application when CMIXNN_PTHREAD is not defined:
+   *        arm_cmixnn_fork() starts job->fn(job->args, job->out_y_begin, job->out_y_end, job->worker)
+   *        on another core and returns, arm_cmixnn_join() waits for its end.
+   */
+  void arm_cmixnn_fork(const cmixnn_job_t *job);
+  void arm_cmixnn_join(const cmixnn_job_t *job);
+#endif
+
+#ifndef CMIXNN_MAX_PATCH_LAYERS
+#define CMIXNN_MAX_PATCH_LAYERS 8
+#endif
+
+  /**
+   * @brief Runs a layer of arm_cmixnn_patch_execute() on a square patch, with no padding.
+   */
+  typedef arm_status (*cmixnn_patch_fn_t)(const uint8_t *Im_in, cmixnn_dim_t dim_im_in, uint8_t *Im_out, cmixnn_dim_t dim_im_out, void *args);
+
+  /**
+   * @brief Layer of a patch-based chain: geometry and packed sizes of its tensors.
+   *        The padding is the same on every side and is filled with z_in, or with raw zeros
+   *        for depthwise layers as their kernels do. The channels of every tensor fill whole bytes.
+   */
+  typedef struct
+  {
+      cmixnn_patch_fn_t fn;
+      void *args;
+      cmixnn_dim_t ch_im_in;
+      cmixnn_dim_t ch_im_out;
+      cmixnn_dim_t dim_kernel;
+      cmixnn_dim_t stride;
+      cmixnn_dim_t dilation;
+      cmixnn_dim_t padding;
+      uint8_t in_bits;
+      uint8_t out_bits;
+      uint8_t z_in;
+      uint8_t depthwise;
+  } cmixnn_patch_layer_t;
+
+  /**
+   * @brief Memory (bytes) and MACs of a patch-based execution and of the layer-by-layer one.
+   */
+  typedef struct
+  {
+      uint32_t buffer_size;
+      uint32_t peak_memory;
+      uint32_t layer_peak_memory;
+      uint64_t macs;
+      uint64_t layer_macs;
+  } cmixnn_patch_plan_t;
+
   /**
  * @defgroup CMixNN_convert CMixNN Data Conversion Functions
  * To be implemented.
@@ -129,6 +239,77 @@ extern "C"
     return source;
   }
 
+  /*
+ * @brief read and expand one s8 word into 2x2xint16_t with reordering
+ */
+  __STATIC_INLINE void *
+  read_and_pad_reordered_s8(void *source, int32_t *out1, int32_t *out2)
+  {
+    int32_t inA = *__SIMD32(source)++;
+#ifndef ARM_MATH_BIG_ENDIAN
+    *out2 = __SXTB16(__ROR(inA, 8));
+    *out1 = __SXTB16(inA);
+#else
+  *out1 = __SXTB16(__ROR(inA, 8));
+  *out2 = __SXTB16(inA);
+#endif
+
+    return source;
+  }
+
+  /**
+  * @brief read and expand one s4 word into 4x2xint16_t with reordering.
+  *        Each nibble is moved to the top of its byte before the sign extension,
+  *        so the outputs are the weights scaled by 16.
+  */
+  __STATIC_INLINE void *read_and_pad_reordered_s4(void *source, int32_t *out1, int32_t *out2, int32_t *out3, int32_t *out4)
+  {
+    int32_t inA = *__SIMD32(source)++;
+#ifndef ARM_MATH_BIG_ENDIAN
+    *out1 = __SXTB16(__ROR(inA, 28) & 0x00F000F0);
+    *out2 = __SXTB16(inA & 0x00F000F0);
+    *out3 = __SXTB16(__ROR(inA, 4) & 0x00F000F0);
+    *out4 = __SXTB16(__ROR(inA, 8) & 0x00F000F0);
+#else
+  *out4 = __SXTB16(__ROR(inA, 28) & 0x00F000F0);
+  *out3 = __SXTB16(inA & 0x00F000F0);
+  *out2 = __SXTB16(__ROR(inA, 4) & 0x00F000F0);
+  *out1 = __SXTB16(__ROR(inA, 8) & 0x00F000F0);
+#endif
+    return source;
+  }
+
+  /**
+  * @brief read and expand one s2 word into 8x2xint16_t with reordering.
+  *        Each crumb is moved to the top of its byte before the sign extension,
+  *        so the outputs are the weights scaled by 64.
+  */
+  __STATIC_INLINE void *read_and_pad_reordered_s2(void *source, int32_t *out1, int32_t *out2, int32_t *out3, int32_t *out4,
+                                                  int32_t *out5, int32_t *out6, int32_t *out7, int32_t *out8)
+  {
+    q31_t inA = *__SIMD32(source)++;
+#ifndef ARM_MATH_BIG_ENDIAN
+    *out1 = __SXTB16(__ROR(inA, 26) & 0x00C000C0);
+    *out2 = __SXTB16(__ROR(inA, 28) & 0x00C000C0);
+    *out3 = __SXTB16(__ROR(inA, 30) & 0x00C000C0);
+    *out4 = __SXTB16(inA & 0x00C000C0);
+    *out5 = __SXTB16(__ROR(inA, 2) & 0x00C000C0);
+    *out6 = __SXTB16(__ROR(inA, 4) & 0x00C000C0);
+    *out7 = __SXTB16(__ROR(inA, 6) & 0x00C000C0);
+    *out8 = __SXTB16(__ROR(inA, 8) & 0x00C000C0);
+#else
+  *out8 = __SXTB16(__ROR(inA, 26) & 0x00C000C0);
+  *out7 = __SXTB16(__ROR(inA, 28) & 0x00C000C0);
+  *out6 = __SXTB16(__ROR(inA, 30) & 0x00C000C0);
+  *out5 = __SXTB16(inA & 0x00C000C0);
+  *out4 = __SXTB16(__ROR(inA, 2) & 0x00C000C0);
+  *out3 = __SXTB16(__ROR(inA, 4) & 0x00C000C0);
+  *out2 = __SXTB16(__ROR(inA, 6) & 0x00C000C0);
+  *out1 = __SXTB16(__ROR(inA, 8) & 0x00C000C0);
+#endif
+    return source;
+  }
+
   __STATIC_INLINE int32_t __HI_SMULL(int32_t a, int32_t b)
   {
     int hi = 0;
@@ -153,114 +334,74 @@ extern "C"
     }
   }
 
-  /* Threasholds from int16 to u4 */
-  __STATIC_INLINE uint8_t __int16_to_u4(int16_t input, const int16_t *pThr)
+  /* Range [k0, k1) of the kernel taps, starting at base and spaced by dil, falling inside [0, dim) */
+  __STATIC_INLINE void __kernel_window(cmixnn_idx_t base, cmixnn_idx_t dim, cmixnn_idx_t dim_kernel, cmixnn_idx_t dil, cmixnn_idx_t *k0, cmixnn_idx_t *k1)
   {
-    uint8_t ret = 0;
-    if (input <= pThr[7])
+    *k0 = (base < 0) ? (dil - 1 - base) / dil : 0;
+    *k1 = (base < dim) ? (dim - base + dil - 1) / dil : 0;
+    if (*k0 > dim_kernel)
+      *k0 = dim_kernel;
+    if (*k1 > dim_kernel)
+      *k1 = dim_kernel;
+    if (*k1 < *k0)
+      *k1 = *k0;
+  }
+
+  /* Gathers the packed ch channels of the n_ker_y x n_ker_x taps of an input window, starting at (in_y, in_x) and
+     spaced by dil (negative for the transposed convolution), at the end of the int16_t im2col column pCol of numCol
+     elements. The pixels of pIn hold ch_stride channels of bits bits, the taps outside the input are set to z_in.
+     The reordered conversion of the returned bytes then fills the column in place from its start, in the word order
+     of the weights, and never overwrites the bytes it still has to read. */
+  __STATIC_INLINE const uint8_t *__im2col_gather(const uint8_t *pIn, cmixnn_idx_t dim_im_in, cmixnn_dim_t ch_stride, cmixnn_dim_t ch, int32_t bits,
+                                                 cmixnn_idx_t in_y, cmixnn_idx_t in_x, cmixnn_idx_t n_ker_y, cmixnn_idx_t n_ker_x, cmixnn_idx_t dil,
+                                                 int32_t z_in, int16_t *pCol, cmixnn_dim_t numCol)
+  {
+    const cmixnn_dim_t tap_bytes = (ch * bits) >> 3;
+    const uint8_t fill = (bits == 8) ? (uint8_t) z_in : (bits == 4) ? (uint8_t) ((z_in & 0x0F) * 0x11) : (uint8_t) ((z_in & 0x03) * 0x55);
+    uint8_t *pStage = (uint8_t *) (pCol + numCol) - n_ker_y * n_ker_x * tap_bytes;
+    uint8_t *pDst = pStage;
+    cmixnn_idx_t i_y, i_x, y, x;
+
+    for (i_y = 0, y = in_y; i_y < n_ker_y; i_y++, y += dil)
     {
-      if (input <= pThr[3])
-      {
-        if (input <= pThr[1])
-        {
-          if (input <= pThr[0])
-            ret = 0;
-          else
-            ret = 1;
-        }
-        else
-        {
-          if (input <= pThr[2])
-            ret = 2;
-          else
-            ret = 3;
-        }
-      }
-      else
+      for (i_x = 0, x = in_x; i_x < n_ker_x; i_x++, x += dil)
       {
-        if (input <= pThr[5])
-        {
-          if (input <= pThr[4])
-            ret = 4;
-          else
-            ret = 5;
-        }
+        if (y < 0 || y >= dim_im_in || x < 0 || x >= dim_im_in)
+          memset(pDst, fill, tap_bytes);
         else
-        {
-          if (input <= pThr[6])
-            ret = 6;
-          else
-            ret = 7;
-        }
+          memcpy(pDst, pIn + ((((int32_t) y * dim_im_in + x) * ch_stride * bits) >> 3), tap_bytes);
+        pDst += tap_bytes;
       }
     }
-    else
+    return pStage;
+  }
+
+  /* Number of thresholds below input, over threshold pairs: __SSUB16 sets the GE flags of the
+     halfwords where thr >= input, __SEL counts the other ones in both halves at once */
+  __STATIC_INLINE int32_t __thr_pairs_below(int32_t in, const int16_t *pThr, uint32_t n_pairs)
+  {
+    const int32_t *pThr32 = (const int32_t *) pThr;
+    int32_t cnt = 0;
+    while (n_pairs--)
     {
-      if (input <= pThr[11])
-      {
-        if (input <= pThr[9])
-        {
-          if (input <= pThr[8])
-            ret = 8;
-          else
-            ret = 9;
-        }
-        else
-        {
-          if (input <= pThr[10])
-            ret = 10;
-          else
-            ret = 11;
-        }
-      }
-      else
-      {
-        if (input <= pThr[13])
-        {
-          if (input <= pThr[12])
-            ret = 12;
-          else
-            ret = 13;
-        }
-        else
-        {
-          if (input <= pThr[14])
-            ret = 14;
-          else
-            ret = 15;
-        }
-      }
+      __SSUB16(*pThr32++, in);
+      cnt += __SEL(0, 0x00010001);
     }
-    return ret;
+    return (cnt + (cnt >> 16)) & 0xFFFF;
+  }
+
+  /* Threasholds from int16 to u4, 15 sorted thresholds per channel */
+  __STATIC_INLINE uint8_t __int16_to_u4(int16_t input, const int16_t *pThr)
+  {
+    const int32_t in = __PKHBT(input, input, 16);
+    return (uint8_t) (__thr_pairs_below(in, pThr, 7) + (input > pThr[14]));
   }
 
-  /* Threasholds from int16 to u2 */
+  /* Threasholds from int16 to u2, 3 sorted thresholds per channel */
   __STATIC_INLINE uint8_t __int16_to_u2(int16_t input, const int16_t *pThr)
   {
-    uint8_t ret = 0;
-    if (input <= pThr[1])
-    {
-      if (input <= pThr[0])
-      {
-        ret = 0;
-      }
-      else
-      {
-        ret = 1;
-      }
-    }
-    else
-    {
-      if (input <= pThr[2])
-      {
-        ret = 2;
-      }
-      else
-      {
-        ret = 3;
-      }
-    }
-    return ret;
+    const int32_t in = __PKHBT(input, input, 16);
+    return (uint8_t) (__thr_pairs_below(in, pThr, 1) + (input > pThr[2]));
   }
 
 #ifdef __cplusplus
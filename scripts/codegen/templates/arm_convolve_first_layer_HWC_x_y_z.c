@@ -0,0 +1,222 @@
+${config.header_top}
+ * Description:  Mixed Precision Convolutional function for the first layer that uses ${config.in_data_t}
+ *               activations, ${config.wt_data_t} weights and produce ${config.out_data_t}
+ *               output activations. Outputs are quantized using ${config.folding}
+ *               folding technique.
+${config.header_bottom}
+
+#include <assert.h>
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXConv
+ * @{
+ */
+
+  /**
+   * @brief Mixed Precision First Layer Convolution ${config.folding} (in: ${config.in_data_t}, out: ${config.out_data_t}, wt: ${config.wt_data_t})
+   *
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimension
+   * @param[in]       ch_im_in    number of input tensor channels, from 1 to 3
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       left_pad    padding sizes
+   * @param[in]       right_pad   padding sizes
+   * @param[in]       top_pad     padding sizes
+   * @param[in]       bottom_pad  padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       z_in        input offset
+% if config.quantization=="PACT":
+   * @param[in]       z_wt        weights offset
+% elif config.quantization=="PACT_CH":
+   * @param[in]       *z_wt       weights offset, per-output channel
+% endif
+% if config.folding=="thr":
+   * @param[in]       thresholds  pointer to thresholds
+% elif config.folding=="icn":
+   * @param[in]       z_out       output offset
+   * @param[in]       *m_zero     pointer to m zero quantization params (per-output-ch)
+   * @param[in]       *n_zero     pointer to n zero quantization params (per-output-ch)
+% else:
+   * @param[in]       z_out       output offset
+   * @param[in]       m_zero      m zero quantization param
+   * @param[in]       n_zero      n zero quantization param
+% endif
+   * @param[in,out]   bufferA     pointer to buffer space for input, 2*ch_im_in*dim_kernel*dim_kernel int16_t
+   * @param[in,out]   bufferB     pointer to buffer space for one padded kernel row, dim_kernel*ch_im_in uint8_t
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * With few input channels a pixel does not fill a SIMD vector, so the im2col converts each
+   * kernel row (dim_kernel*ch_im_in contiguous values) at once. Rows crossing the left or right
+   * border are first gathered in bufferB, where the padded pixels are set to z_in.
+   *
+   * Each filter row holds the dim_kernel kernel rows one after the other; the values of every
+   * kernel row are reordered as a single vector of dim_kernel*ch_im_in elements.
+   */
+arm_status
+${config.fn_name}(const uint8_t *Im_in,
+                    const cmixnn_dim_t dim_im_in,
+                    const cmixnn_dim_t ch_im_in,
+                    const uint8_t *wt,
+                    const cmixnn_dim_t ch_im_out,
+                    const cmixnn_dim_t dim_kernel,
+                    const uint8_t left_padding,
+                    const uint8_t right_padding,
+                    const uint8_t top_padding,
+                    const uint8_t bottom_padding,
+                    const cmixnn_dim_t stride,
+                    const int32_t *bias,
+                    uint8_t *Im_out,
+                    const cmixnn_dim_t dim_im_out,
+                    const uint8_t z_in,
+% if config.quantization == "PACT":
+                    const uint8_t z_wt,
+% elif config.quantization == "PACT_CH":
+                    const uint8_t *z_wt,
+% endif
+% if config.folding == "thr":
+                    const int16_t *thresholds,
+% else:
+                    const uint8_t z_out,
+%   if config.folding == "icn":
+                    const int32_t *m_zero,
+                    const int8_t *n_zero,
+%   else:
+                    const int32_t m_zero,
+                    const int8_t n_zero,
+%   endif
+% endif
+                    int16_t * bufferA,
+                    uint8_t *bufferB)
+{
+
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    cmixnn_idx_t i_out_y, i_out_x, i_ker_y, i_ker_x, i_ch;
+    int16_t *pBuffer = bufferA;
+    uint8_t *pOut = Im_out;
+    const cmixnn_dim_t ker_row = ch_im_in * dim_kernel;
+    const cmixnn_dim_t numCol = ker_row * dim_kernel;
+
+    if (ch_im_in == 0 || ch_im_in > 3 || ch_im_out % ${config.ch_out_constrain} != 0)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    for (i_out_y = 0; i_out_y < dim_im_out; i_out_y++)
+    {
+        for (i_out_x = 0; i_out_x < dim_im_out; i_out_x++)
+        {
+            const cmixnn_idx_t i_in_x = i_out_x * stride - left_padding;
+
+            /* This part implements the im2col function, one kernel row at a time */
+            for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+            {
+                if (i_ker_y < 0 || i_ker_y >= dim_im_in)
+                {
+                    memset(pBuffer, 0, sizeof(int16_t) * ker_row);
+                }
+                else if (i_in_x >= 0 && i_in_x + dim_kernel <= dim_im_in)
+                {
+                    ${config.reordered_no_shift_load_fn}(Im_in + (i_ker_y * dim_im_in + i_in_x) * ch_im_in,
+                                                pBuffer,
+                                                ker_row,
+                                                z_in);
+                }
+                else
+                {
+                    /* border row: pad with z_in, that is zero once the offset is removed */
+                    uint8_t *pRow = bufferB;
+                    for (i_ker_x = i_in_x; i_ker_x < i_in_x + dim_kernel; i_ker_x++)
+                    {
+                        for (i_ch = 0; i_ch < ch_im_in; i_ch++)
+                        {
+                            if (i_ker_x < 0 || i_ker_x >= dim_im_in)
+                            {
+                                *pRow++ = z_in;
+                            }
+                            else
+                            {
+                                *pRow++ = Im_in[(i_ker_y * dim_im_in + i_ker_x) * ch_im_in + i_ch];
+                            }
+                        }
+                    }
+                    ${config.reordered_no_shift_load_fn}(bufferB,
+                                                pBuffer,
+                                                ker_row,
+                                                z_in);
+                }
+                pBuffer += ker_row;
+            }
+
+            if (pBuffer == bufferA + 2 * numCol)
+            {
+                pOut = ${config.nn_mat_mul_fn}(wt,
+                                                bufferA,
+                                                ch_im_out,
+                                                numCol,
+                                                bias,
+                                                pOut,
+                                                z_wt,
+% if config.folding == "thr":
+                                                thresholds);
+% else:
+                                                z_out,
+                                                m_zero,
+                                                n_zero);
+% endif
+                /* counter reset */
+                pBuffer = bufferA;
+            }
+        }
+    }
+
+    /* check if there is left-over for compute */
+    if (pBuffer != bufferA)
+    {
+        /* single pixel left: duplicate its column and compute it twice in place */
+        memcpy(pBuffer, bufferA, sizeof(int16_t) * numCol);
+        ${config.nn_mat_mul_strided_fn}(wt,
+                                                bufferA,
+                                                ch_im_out,
+                                                numCol,
+                                                bias,
+                                                pOut,
+                                                0,
+                                                z_wt,
+% if config.folding == "thr":
+                                                thresholds);
+% else:
+                                                z_out,
+                                                m_zero,
+                                                n_zero);
+% endif
+    }
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXConv group
+ */
\ No newline at end of file
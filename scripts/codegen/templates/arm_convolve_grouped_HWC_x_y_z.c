@@ -0,0 +1,348 @@
+<%
+    in_stride = "in_pix_stride" if config.sliced else "ch_im_in"
+    out_stride = "out_pix_stride" if config.sliced else "ch_im_out"
+    in_ch = "in_ch_offset + g * ch_in_g" if config.sliced else "g * ch_in_g"
+    out_ch = "out_ch_offset + g * ch_out_g" if config.sliced else "g * ch_out_g"
+    in_bits = {'u8': 8, 'u4': 4, 'u2': 2}[config.in_data_t]
+%>\
+${config.header_top}
+% if config.sliced:
+ * Description:  Mixed Precision Convolutional function on channel slices that uses ${config.in_data_t}
+% else:
+ * Description:  Mixed Precision Grouped Convolutional function that uses ${config.in_data_t}
+% endif
+ *               activations, ${config.wt_data_t} weights and produce ${config.out_data_t}
+ *               output activations. Outputs are quantized using ${config.folding}
+ *               folding technique.
+${config.header_bottom}
+
+#include <assert.h>
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXConv
+ * @{
+ */
+
+  /**
+% if config.sliced:
+   * @brief Mixed Precision Sliced Convolution ${config.folding} (in: ${config.in_data_t}, out: ${config.out_data_t}, wt: ${config.wt_data_t})
+   *
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimension
+   * @param[in]       ch_im_in    number of input channels read by the layer
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output channels written by the layer
+% else:
+   * @brief Mixed Precision Grouped Convolution ${config.folding} (in: ${config.in_data_t}, out: ${config.out_data_t}, wt: ${config.wt_data_t})
+   *
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimension
+   * @param[in]       ch_im_in    number of input tensor channels (all groups)
+   * @param[in]       wt          pointer to kernel weights, stored group by group
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels (all groups)
+% endif
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       left_pad    padding sizes
+   * @param[in]       right_pad   padding sizes
+   * @param[in]       top_pad     padding sizes
+   * @param[in]       bottom_pad  padding sizes
+   * @param[in]       stride      convolution stride
+% if config.sliced:
+   * @param[in]       in_ch_offset  first input channel read, in each pixel of Im_in
+   * @param[in]       in_pix_stride number of channels of an Im_in pixel
+   * @param[in]       out_ch_offset first output channel written, in each pixel of Im_out
+   * @param[in]       out_pix_stride number of channels of an Im_out pixel
+% else:
+   * @param[in]       groups      number of groups, each one convolving ch_im_in/groups input channels
+% endif
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       z_in        input offset
+% if config.quantization=="PACT":
+   * @param[in]       z_wt        weights offset
+% elif config.quantization=="PACT_CH":
+   * @param[in]       *z_wt       weights offset, per-output channel
+% endif
+% if config.folding=="thr":
+   * @param[in]       thresholds  pointer to thresholds
+% elif config.folding=="icn":
+   * @param[in]       z_out       output offset
+   * @param[in]       *m_zero     pointer to m zero quantization params (per-output-ch)
+   * @param[in]       *n_zero     pointer to n zero quantization params (per-output-ch)
+% else:
+   * @param[in]       z_out       output offset
+   * @param[in]       m_zero      m zero quantization param
+   * @param[in]       n_zero      n zero quantization param
+% endif
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+% if config.sliced:
+   * @details
+   *
+   * The layer reads the channels [in_ch_offset, in_ch_offset + ch_im_in) of a packed HWC input with
+   * in_pix_stride channels per pixel, and writes the channels [out_ch_offset, out_ch_offset + ch_im_out)
+   * of a packed HWC output with out_pix_stride channels per pixel. Branches writing disjoint channel
+   * ranges of the same output make the concatenation free, and a layer reading a channel range of a
+   * larger tensor makes the split free. The other output channels are left untouched.
+   *
+   * <b>Constraints</b>: in_ch_offset and in_pix_stride multiple of ${config.ch_in_slice_constrain}, out_ch_offset and
+   * out_pix_stride multiple of ${config.ch_out_slice_constrain}, so that every slice starts on a byte of the packed tensors.
+% else:
+   * @details
+   *
+   * Group g reads the input channels [g*ch_im_in/groups, (g+1)*ch_im_in/groups) directly from
+   * the packed HWC input and writes its ch_im_out/groups output channels at the matching
+   * channel offset of the packed HWC output, so no channel gathering or scattering is needed.
+% endif
+   */
+arm_status
+${config.fn_name}(const uint8_t *Im_in,
+                    const cmixnn_dim_t dim_im_in,
+                    const cmixnn_dim_t ch_im_in,
+                    const uint8_t *wt,
+                    const cmixnn_dim_t ch_im_out,
+                    const cmixnn_dim_t dim_kernel,
+                    const uint8_t left_padding,
+                    const uint8_t right_padding,
+                    const uint8_t top_padding,
+                    const uint8_t bottom_padding,
+                    const cmixnn_dim_t stride,
+% if config.sliced:
+                    const cmixnn_dim_t in_ch_offset,
+                    const cmixnn_dim_t in_pix_stride,
+                    const cmixnn_dim_t out_ch_offset,
+                    const cmixnn_dim_t out_pix_stride,
+% else:
+                    const cmixnn_dim_t groups,
+% endif
+                    const int32_t *bias,
+                    uint8_t *Im_out,
+                    const cmixnn_dim_t dim_im_out,
+                    const uint8_t z_in,
+% if config.quantization == "PACT":
+                    const uint8_t z_wt,
+% elif config.quantization == "PACT_CH":
+                    const uint8_t *z_wt,
+% endif
+% if config.folding == "thr":
+                    const int16_t *thresholds,
+% else:
+                    const uint8_t z_out,
+%   if config.folding == "icn":
+                    const int32_t *m_zero,
+                    const int8_t *n_zero,
+%   else:
+                    const int32_t m_zero,
+                    const int8_t n_zero,
+%   endif
+% endif
+                    int16_t * bufferA,
+                    uint8_t *bufferB)
+{
+
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    cmixnn_idx_t i_out_y, i_out_x, i_ker_y, i_ker_x;
+    int16_t *pBuffer = bufferA;
+    uint8_t *pOut = Im_out;
+    cmixnn_dim_t g;
+% if config.sliced:
+    const cmixnn_dim_t groups = 1;
+
+    if (in_ch_offset % ${config.ch_in_slice_constrain} != 0 || in_pix_stride % ${config.ch_in_slice_constrain} != 0
+        || in_ch_offset + ch_im_in > in_pix_stride
+        || out_ch_offset % ${config.ch_out_slice_constrain} != 0 || out_pix_stride % ${config.ch_out_slice_constrain} != 0
+        || out_ch_offset + ch_im_out > out_pix_stride)
+    {
+        /* check if the channel slices fill whole bytes of the tensors */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+% endif
+
+    if (groups == 0 || ch_im_in % groups != 0 || ch_im_out % groups != 0)
+    {
+        /* check if the channels can be split in groups */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    /* per-group input channels, output channels and matrix columns */
+    const cmixnn_dim_t ch_in_g = ch_im_in / groups;
+    const cmixnn_dim_t ch_out_g = ch_im_out / groups;
+    const cmixnn_dim_t numCol = ch_in_g * dim_kernel * dim_kernel;
+
+    if (ch_in_g % ${config.ch_in_constrain} != 0 || ch_out_g % ${config.ch_out_constrain} != 0)
+    {
+        /* check if the group dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    for (g = 0; g < groups; g++)
+    {
+        /* channel slices of the input/output tensors and parameters of this group */
+% if config.in_data_t == 'u8':
+        const uint8_t *Im_in_g = Im_in + ${in_ch};
+% elif config.in_data_t == 'u4':
+        const uint8_t *Im_in_g = Im_in + ((${in_ch}) >> 1);
+% elif config.in_data_t == 'u2':
+        const uint8_t *Im_in_g = Im_in + ((${in_ch}) >> 2);
+% endif
+% if config.wt_data_t == 'u8':
+        const uint8_t *wt_g = wt + g * ch_out_g * numCol;
+% elif config.wt_data_t == 'u4':
+        const uint8_t *wt_g = wt + g * ch_out_g * ((numCol + 1) >> 1);
+% elif config.wt_data_t == 'u2':
+        const uint8_t *wt_g = wt + g * ch_out_g * ((numCol + 3) >> 2);
+% endif
+        const int32_t *bias_g = bias + g * ch_out_g;
+% if config.quantization == "PACT_CH":
+        const uint8_t *z_wt_g = z_wt + g * ch_out_g;
+% endif
+% if config.folding == "thr":
+%   if config.out_data_t == 'u4':
+        const int16_t *thresholds_g = thresholds + ((g * ch_out_g) << 4);
+%   else:
+        const int16_t *thresholds_g = thresholds + ((g * ch_out_g) << 2);
+%   endif
+% elif config.folding == "icn":
+        const int32_t *m_zero_g = m_zero + g * ch_out_g;
+        const int8_t *n_zero_g = n_zero + g * ch_out_g;
+% endif
+% if config.out_data_t == 'u8':
+        pOut = Im_out + ${out_ch};
+% elif config.out_data_t == 'u4':
+        pOut = Im_out + ((${out_ch}) >> 1);
+% elif config.out_data_t == 'u2':
+        pOut = Im_out + ((${out_ch}) >> 2);
+% endif
+        pBuffer = bufferA;
+
+        for (i_out_y = 0; i_out_y < dim_im_out; i_out_y++)
+        {
+            for (i_out_x = 0; i_out_x < dim_im_out; i_out_x++)
+            {
+                if (ch_in_g % ${config.ch_in_vect} != 0)
+                {
+                    /* pixels do not fill whole vectors: gather the packed window, padded with z_in, and convert it at once */
+                    ${config.reordered_no_shift_load_fn}(__im2col_gather(Im_in_g, dim_im_in, ${in_stride}, ch_in_g, ${in_bits},
+                                                                i_out_y * stride - top_padding, i_out_x * stride - left_padding,
+                                                                dim_kernel, dim_kernel, 1, z_in, pBuffer, numCol),
+                                                pBuffer,
+                                                numCol,
+                                                z_in);
+                    pBuffer += numCol;
+                }
+                else
+                {
+                    /* This part implements the im2col function over the channel slice of the group */
+                    for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+                    {
+                        for (i_ker_x = i_out_x * stride - left_padding; i_ker_x < i_out_x * stride - left_padding + dim_kernel; i_ker_x++)
+                        {
+                            if (i_ker_y < 0 || i_ker_y >= dim_im_in || i_ker_x < 0 || i_ker_x >= dim_im_in)
+                            {
+                                memset(pBuffer, 0, sizeof(int16_t) * ch_in_g);
+                            }
+                            else
+                            {
+                                ${config.reordered_no_shift_load_fn}(
+% if config.in_data_t == 'u8':
+                                                    Im_in_g + (i_ker_y * dim_im_in + i_ker_x) * ${in_stride},
+% elif config.in_data_t == 'u4':
+                                                    Im_in_g + (((i_ker_y * dim_im_in + i_ker_x) * ${in_stride}) >> 1),
+% elif config.in_data_t == 'u2':
+                                                    Im_in_g + (((i_ker_y * dim_im_in + i_ker_x) * ${in_stride}) >> 2),
+% endif
+                                                    pBuffer,
+                                                    ch_in_g,
+                                                    z_in);
+                            }
+                            pBuffer += ch_in_g;
+                        }
+                    }
+                }
+
+                if (pBuffer == bufferA + 2 * numCol)
+                {
+                    pOut = ${config.nn_mat_mul_fn}(wt_g,
+                                                bufferA,
+                                                ch_out_g,
+                                                numCol,
+                                                bias_g,
+                                                pOut,
+                                                ${out_stride},
+% if config.quantization == "PACT_CH":
+                                                z_wt_g,
+% else:
+                                                z_wt,
+% endif
+% if config.folding == "thr":
+                                                thresholds_g);
+% elif config.folding == "icn":
+                                                z_out,
+                                                m_zero_g,
+                                                n_zero_g);
+% else:
+                                                z_out,
+                                                m_zero,
+                                                n_zero);
+% endif
+                    /* counter reset */
+                    pBuffer = bufferA;
+                }
+            }
+        }
+
+        /* check if there is left-over for compute */
+        if (pBuffer != bufferA)
+        {
+            /* single pixel left: duplicate its column and compute it twice in place */
+            memcpy(pBuffer, bufferA, sizeof(int16_t) * numCol);
+            ${config.nn_mat_mul_fn}(wt_g,
+                                                bufferA,
+                                                ch_out_g,
+                                                numCol,
+                                                bias_g,
+                                                pOut,
+                                                0,
+% if config.quantization == "PACT_CH":
+                                                z_wt_g,
+% else:
+                                                z_wt,
+% endif
+% if config.folding == "thr":
+                                                thresholds_g);
+% elif config.folding == "icn":
+                                                z_out,
+                                                m_zero_g,
+                                                n_zero_g);
+% else:
+                                                z_out,
+                                                m_zero,
+                                                n_zero);
+% endif
+        }
+    }
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXConv group
+ */
\ No newline at end of file
@@ -0,0 +1,236 @@
+<%
+    # packing of the activations, the same for the signed ones
+    in_t = config.in_data_t.replace('s', 'u')
+    in_bits = {'u8': 8, 'u4': 4, 'u2': 2}[in_t]
+%>\
+${config.header_top}
+ * Description:  Mixed Precision Convolutional function that uses ${config.in_data_t}
+ *               activations, ${config.wt_data_t} weights and produce the raw ${config.out_data_t}
+ *               accumulators, with no requantization.
+${config.header_bottom}
+
+#include <assert.h>
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXConv
+ * @{
+ */
+
+  /**
+   * @brief Mixed Precision Convolution with raw ${config.out_data_t} output (in: ${config.in_data_t}, wt: ${config.wt_data_t})
+   *
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimension
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       left_pad    padding sizes
+   * @param[in]       right_pad   padding sizes
+   * @param[in]       top_pad     padding sizes
+   * @param[in]       bottom_pad  padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   Im_out      pointer to output tensor, ${config.out_data_t}_t elements (${int(config.out_data_t[3:]) // 8}-byte aligned)
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       z_in        input offset
+% if config.quantization=="PACT":
+   * @param[in]       z_wt        weights offset
+% elif config.quantization=="PACT_CH":
+   * @param[in]       *z_wt       weights offset, per-output channel
+% endif
+% if config.out_data_t == 'int16':
+   * @param[in]       n_zero      right shift of the accumulators, 0 to 31
+% endif
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   bufferB     pointer to buffer space for the sums of a pixel pair, 2*ch_im_out int32_t (32-bit aligned)
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+% if config.out_data_t == 'int32':
+   * The output is the int32_t accumulator of each output channel, bias included, for the heads
+   * feeding a softmax, an argmax or a box decoding. The pixel pairs are accumulated in place in
+   * Im_out by the int32_t Matrix-Multiplication, only a leftover pixel goes through bufferB.
+% else:
+   * The output is the accumulator of each output channel, bias included, rounded and shifted
+   * right by n_zero and saturated to int16_t: out = __SSAT((sum + 2^(n_zero-1)) >> n_zero, 16).
+   * The pixel pairs are computed with the int32_t Matrix-Multiplication into bufferB.
+% endif
+   * The weights have the same layout as the plain convolution.
+   */
+arm_status
+${config.fn_name}(const uint8_t *Im_in,
+                    const cmixnn_dim_t dim_im_in,
+                    const cmixnn_dim_t ch_im_in,
+                    const uint8_t *wt,
+                    const cmixnn_dim_t ch_im_out,
+                    const cmixnn_dim_t dim_kernel,
+                    const uint8_t left_padding,
+                    const uint8_t right_padding,
+                    const uint8_t top_padding,
+                    const uint8_t bottom_padding,
+                    const cmixnn_dim_t stride,
+                    const int32_t *bias,
+                    ${config.out_ptr_t} *Im_out,
+                    const cmixnn_dim_t dim_im_out,
+                    const ${config.z_in_t} z_in,
+% if config.quantization == "PACT":
+                    const uint8_t z_wt,
+% elif config.quantization == "PACT_CH":
+                    const uint8_t *z_wt,
+% endif
+% if config.out_data_t == 'int16':
+                    const int8_t n_zero,
+% endif
+                    int16_t * bufferA,
+                    uint8_t *bufferB)
+{
+
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    cmixnn_idx_t i_out_y, i_out_x, i_ker_y, i_ker_x;
+    int16_t *pBuffer = bufferA;
+    int32_t *pSum = (int32_t *) bufferB;
+    const cmixnn_dim_t numCol = ch_im_in * dim_kernel * dim_kernel;
+    const int32_t num_pix = dim_im_out * dim_im_out;
+    int32_t i_pix;
+    cmixnn_dim_t i_ch, i_col;
+% if config.out_data_t == 'int16':
+    int32_t i_el, el_end;
+    const int32_t n_round = (int32_t) ((1u << n_zero) >> 1);
+% endif
+
+    if (ch_im_in % ${config.ch_in_constrain} != 0 || ch_im_out % ${config.ch_out_constrain} != 0)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    for (i_pix = 0; i_pix < num_pix; i_pix += 2)
+    {
+        /* This part implements the im2col function, a leftover pixel fills both columns */
+        pBuffer = bufferA;
+        for (i_col = 0; i_col < 2; i_col++)
+        {
+            i_out_y = (i_pix + (i_col && i_pix + 1 < num_pix)) / dim_im_out;
+            i_out_x = (i_pix + (i_col && i_pix + 1 < num_pix)) % dim_im_out;
+            if (ch_im_in % ${config.ch_in_vect} != 0)
+            {
+                /* pixels do not fill whole vectors: gather the packed window, padded with z_in, and convert it at once */
+                ${config.reordered_no_shift_load_fn}(__im2col_gather(Im_in, dim_im_in, ch_im_in, ch_im_in, ${in_bits},
+                                                            i_out_y * stride - top_padding, i_out_x * stride - left_padding,
+                                                            dim_kernel, dim_kernel, 1, z_in, pBuffer, numCol),
+                                            pBuffer,
+                                            numCol,
+                                            z_in);
+                pBuffer += numCol;
+                continue;
+            }
+            for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+            {
+                if (i_ker_y < 0 || i_ker_y >= dim_im_in)
+                {
+                    memset(pBuffer, 0, sizeof(int16_t) * ch_im_in * dim_kernel);
+                    pBuffer += ch_im_in * dim_kernel;
+                }
+                else if (i_out_x * stride - left_padding >= 0
+                         && i_out_x * stride - left_padding + dim_kernel <= dim_im_in)
+                {
+                    /* the kernel row lies in the input: load it at once */
+                    ${config.reordered_no_shift_load_fn}(
+% if in_t == 'u8':
+                                        Im_in + (i_ker_y * dim_im_in + i_out_x * stride - left_padding) * ch_im_in,
+% elif in_t == 'u4':
+                                        Im_in + (((i_ker_y * dim_im_in + i_out_x * stride - left_padding) * ch_im_in) >> 1),
+% elif in_t == 'u2':
+                                        Im_in + (((i_ker_y * dim_im_in + i_out_x * stride - left_padding) * ch_im_in) >> 2),
+% endif
+                                        pBuffer,
+                                        ch_im_in * dim_kernel,
+                                        z_in);
+                    pBuffer += ch_im_in * dim_kernel;
+                }
+                else
+                {
+                    for (i_ker_x = i_out_x * stride - left_padding; i_ker_x < i_out_x * stride - left_padding + dim_kernel; i_ker_x++)
+                    {
+                        if (i_ker_x < 0 || i_ker_x >= dim_im_in)
+                        {
+                            memset(pBuffer, 0, sizeof(int16_t) * ch_im_in);
+                        }
+                        else
+                        {
+                            ${config.reordered_no_shift_load_fn}(
+% if in_t == 'u8':
+                                        Im_in + (i_ker_y * dim_im_in + i_ker_x) * ch_im_in,
+% elif in_t == 'u4':
+                                        Im_in + (((i_ker_y * dim_im_in + i_ker_x) * ch_im_in) >> 1),
+% elif in_t == 'u2':
+                                        Im_in + (((i_ker_y * dim_im_in + i_ker_x) * ch_im_in) >> 2),
+% endif
+                                        pBuffer,
+                                        ch_im_in,
+                                        z_in);
+                        }
+                        pBuffer += ch_im_in;
+                    }
+                }
+            }
+        }
+
+% if config.out_data_t == 'int32':
+        /* a pixel pair is accumulated in place, a leftover pixel in bufferB */
+        pSum = (i_pix + 1 < num_pix) ? Im_out + i_pix * ch_im_out : (int32_t *) bufferB;
+% endif
+        /* sums of the pixel pair start from the bias */
+        for (i_ch = 0; i_ch < ch_im_out; i_ch++)
+        {
+            pSum[i_ch] = bias[i_ch];
+            pSum[ch_im_out + i_ch] = bias[i_ch];
+        }
+        ${config.nn_mat_mul_partial_fn}(wt,
+                                        bufferA,
+                                        ch_im_out,
+                                        numCol,
+                                        numCol,
+                                        numCol,
+                                        numCol,
+                                        pSum,
+                                        z_wt);
+
+% if config.out_data_t == 'int32':
+        if (i_pix + 1 >= num_pix)
+        {
+            memcpy(Im_out + i_pix * ch_im_out, pSum, sizeof(int32_t) * ch_im_out);
+        }
+% else:
+        /* shift, saturate and store the pixel pair */
+        el_end = (i_pix + 1 < num_pix ? 2 : 1) * ch_im_out;
+        for (i_el = 0; i_el < el_end; i_el++)
+        {
+            Im_out[i_pix * ch_im_out + i_el] = (int16_t) __SSAT((pSum[i_el] + n_round) >> n_zero, 16);
+        }
+% endif
+    }
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXConv group
+ */
@@ -0,0 +1,315 @@
+<%
+    # bits of a packed input activation
+    in_bits = {'u8': 8, 'u4': 4, 'u2': 2}[config.in_data_t]
+%>\
+${config.header_top}
+ * Description:  Mixed Precision Convolutional function with residual add that uses ${config.in_data_t}
+ *               activations, ${config.res_data_t} residual, ${config.wt_data_t} weights and produce
+ *               ${config.out_data_t} output activations. Outputs are quantized using ${config.folding}
+ *               folding technique.
+${config.header_bottom}
+
+#include <assert.h>
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXConv
+ * @{
+ */
+
+  /**
+   * @brief Mixed Precision Convolution with Residual Add ${config.folding} (in: ${config.in_data_t}, res: ${config.res_data_t}, out: ${config.out_data_t}, wt: ${config.wt_data_t})
+   *
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimension
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       left_pad    padding sizes
+   * @param[in]       right_pad   padding sizes
+   * @param[in]       top_pad     padding sizes
+   * @param[in]       bottom_pad  padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in]       Im_res      pointer to residual tensor, same shape as the output
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       z_in        input offset
+% if config.quantization=="PACT":
+   * @param[in]       z_wt        weights offset
+% elif config.quantization=="PACT_CH":
+   * @param[in]       *z_wt       weights offset, per-output channel
+% endif
+% if config.folding=="thr":
+   * @param[in]       thresholds  pointer to thresholds
+% elif config.folding=="icn":
+   * @param[in]       z_out       output offset
+   * @param[in]       *m_zero     pointer to m zero quantization params (per-output-ch)
+   * @param[in]       *n_zero     pointer to n zero quantization params (per-output-ch)
+% else:
+   * @param[in]       z_out       output offset
+   * @param[in]       m_zero      m zero quantization param
+   * @param[in]       n_zero      n zero quantization param
+% endif
+   * @param[in]       z_res       residual offset
+   * @param[in]       m_res       residual m quantization param
+   * @param[in]       n_res       residual n quantization param
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   bufferB     pointer to buffer space for the sums of a pixel pair, 2*ch_im_out int32_t (32-bit aligned)
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * out = requant(conv) + requant(Im_res - z_res): the residual, rescaled by (m_res, n_res) relative
+   * to the output, is added to the normalized convolution output before the saturation, so the
+   * output is stored once. The pixel pairs are computed with the int32_t Matrix-Multiplication and
+   * the weights have the same layout as the plain convolution.
+   */
+arm_status
+${config.fn_name}(const uint8_t *Im_in,
+                    const cmixnn_dim_t dim_im_in,
+                    const cmixnn_dim_t ch_im_in,
+                    const uint8_t *wt,
+                    const cmixnn_dim_t ch_im_out,
+                    const cmixnn_dim_t dim_kernel,
+                    const uint8_t left_padding,
+                    const uint8_t right_padding,
+                    const uint8_t top_padding,
+                    const uint8_t bottom_padding,
+                    const cmixnn_dim_t stride,
+                    const int32_t *bias,
+                    const uint8_t *Im_res,
+                    uint8_t *Im_out,
+                    const cmixnn_dim_t dim_im_out,
+                    const uint8_t z_in,
+% if config.quantization == "PACT":
+                    const uint8_t z_wt,
+% elif config.quantization == "PACT_CH":
+                    const uint8_t *z_wt,
+% endif
+% if config.folding == "thr":
+                    const int16_t *thresholds,
+% else:
+                    const uint8_t z_out,
+%   if config.folding == "icn":
+                    const int32_t *m_zero,
+                    const int8_t *n_zero,
+%   else:
+                    const int32_t m_zero,
+                    const int8_t n_zero,
+%   endif
+% endif
+                    const uint8_t z_res,
+                    const int32_t m_res,
+                    const int8_t n_res,
+                    int16_t * bufferA,
+                    uint8_t *bufferB)
+{
+
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    cmixnn_idx_t i_out_y, i_out_x, i_ker_y, i_ker_x;
+    int16_t *pBuffer = bufferA;
+    uint8_t *pOut = Im_out;
+    int32_t *pSum = (int32_t *) bufferB;
+    const cmixnn_dim_t numCol = ch_im_in * dim_kernel * dim_kernel;
+    const int32_t num_pix = dim_im_out * dim_im_out;
+    int32_t i_pix, i_el, i_res, el_end;
+    cmixnn_dim_t i_ch, i_col;
+% if config.folding == "weights":
+    /* Negative N_ZERO Normalization */
+    int8_t n_zero1;
+    int8_t n_zero2;
+    __n_zero_negative_normalization(n_zero,&n_zero1,&n_zero2);
+% elif config.folding == "icn":
+    /* Negative N_ZERO Normalization */
+    int8_t n_zero1;
+    int8_t n_zero2;
+% endif
+    int8_t n_res1;
+    int8_t n_res2;
+    __n_zero_negative_normalization(n_res,&n_res1,&n_res2);
+
+    if (ch_im_in % ${config.ch_in_constrain} != 0 || ch_im_out % ${config.ch_out_constrain} != 0)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    for (i_pix = 0; i_pix < num_pix; i_pix += 2)
+    {
+        /* This part implements the im2col function, a leftover pixel fills both columns */
+        pBuffer = bufferA;
+        for (i_col = 0; i_col < 2; i_col++)
+        {
+            i_out_y = (i_pix + (i_col && i_pix + 1 < num_pix)) / dim_im_out;
+            i_out_x = (i_pix + (i_col && i_pix + 1 < num_pix)) % dim_im_out;
+            if (ch_im_in % ${config.ch_in_vect} != 0)
+            {
+                /* pixels do not fill whole vectors: gather the packed window, padded with z_in, and convert it at once */
+                ${config.reordered_no_shift_load_fn}(__im2col_gather(Im_in, dim_im_in, ch_im_in, ch_im_in, ${in_bits},
+                                                            i_out_y * stride - top_padding, i_out_x * stride - left_padding,
+                                                            dim_kernel, dim_kernel, 1, z_in, pBuffer, numCol),
+                                            pBuffer,
+                                            numCol,
+                                            z_in);
+                pBuffer += numCol;
+                continue;
+            }
+            for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+            {
+                if (i_ker_y < 0 || i_ker_y >= dim_im_in)
+                {
+                    memset(pBuffer, 0, sizeof(int16_t) * ch_im_in * dim_kernel);
+                    pBuffer += ch_im_in * dim_kernel;
+                }
+                else if (i_out_x * stride - left_padding >= 0
+                         && i_out_x * stride - left_padding + dim_kernel <= dim_im_in)
+                {
+                    /* the kernel row lies in the input: load it at once */
+                    ${config.reordered_no_shift_load_fn}(
+% if config.in_data_t == 'u8':
+                                        Im_in + (i_ker_y * dim_im_in + i_out_x * stride - left_padding) * ch_im_in,
+% elif config.in_data_t == 'u4':
+                                        Im_in + (((i_ker_y * dim_im_in + i_out_x * stride - left_padding) * ch_im_in) >> 1),
+% elif config.in_data_t == 'u2':
+                                        Im_in + (((i_ker_y * dim_im_in + i_out_x * stride - left_padding) * ch_im_in) >> 2),
+% endif
+                                        pBuffer,
+                                        ch_im_in * dim_kernel,
+                                        z_in);
+                    pBuffer += ch_im_in * dim_kernel;
+                }
+                else
+                {
+                    for (i_ker_x = i_out_x * stride - left_padding; i_ker_x < i_out_x * stride - left_padding + dim_kernel; i_ker_x++)
+                    {
+                        if (i_ker_x < 0 || i_ker_x >= dim_im_in)
+                        {
+                            memset(pBuffer, 0, sizeof(int16_t) * ch_im_in);
+                        }
+                        else
+                        {
+                            ${config.reordered_no_shift_load_fn}(
+% if config.in_data_t == 'u8':
+                                        Im_in + (i_ker_y * dim_im_in + i_ker_x) * ch_im_in,
+% elif config.in_data_t == 'u4':
+                                        Im_in + (((i_ker_y * dim_im_in + i_ker_x) * ch_im_in) >> 1),
+% elif config.in_data_t == 'u2':
+                                        Im_in + (((i_ker_y * dim_im_in + i_ker_x) * ch_im_in) >> 2),
+% endif
+                                        pBuffer,
+                                        ch_im_in,
+                                        z_in);
+                        }
+                        pBuffer += ch_im_in;
+                    }
+                }
+            }
+        }
+
+        /* sums of the pixel pair start from the bias */
+        for (i_ch = 0; i_ch < ch_im_out; i_ch++)
+        {
+            pSum[i_ch] = bias[i_ch];
+            pSum[ch_im_out + i_ch] = bias[i_ch];
+        }
+        ${config.nn_mat_mul_partial_fn}(wt,
+                                        bufferA,
+                                        ch_im_out,
+                                        numCol,
+                                        numCol,
+                                        numCol,
+                                        numCol,
+                                        pSum,
+                                        z_wt);
+
+        /* quantize, add the residual and store the pixel pair */
+% if config.out_data_t == 'u8':
+        pOut = Im_out + i_pix * ch_im_out;
+% elif config.out_data_t == 'u4':
+        pOut = Im_out + ((i_pix * ch_im_out) >> 1);
+% elif config.out_data_t == 'u2':
+        pOut = Im_out + ((i_pix * ch_im_out) >> 2);
+% endif
+        /* i_el is relative to the pixel pair, which starts on a byte boundary of the packed output */
+        el_end = (i_pix + 1 < num_pix ? 2 : 1) * ch_im_out;
+        for (i_el = 0; i_el < el_end; i_el++)
+        {
+            int32_t sum = pSum[i_el];
+            i_res = i_pix * ch_im_out + i_el;
+% if config.res_data_t == 'u8':
+            int32_t res = Im_res[i_res] - z_res;
+% elif config.res_data_t == 'u4':
+            int32_t res = ((Im_res[i_res >> 1] >> ((i_res & 0x1) << 2)) & 0x0F) - z_res;
+% elif config.res_data_t == 'u2':
+            int32_t res = ((Im_res[i_res >> 2] >> ((i_res & 0x3) << 1)) & 0x03) - z_res;
+% endif
+
+            i_ch = i_el % ch_im_out;
+% if config.folding == "thr":
+            /* Normalize by Thresholds (${config.out_data_t} output) */
+%   if config.out_data_t == 'u8':
+            #warning No threasholds available at u8
+%   elif config.out_data_t == 'u4':
+            sum = __int16_to_u4((int16_t) sum, &thresholds[i_ch << 4]);
+%   elif config.out_data_t == 'u2':
+            sum = __int16_to_u2((int16_t) sum, &thresholds[i_ch << 2]);
+%   endif
+% elif config.folding == "icn":
+            /* Normalize by ICN (${config.out_data_t} output) */
+            __n_zero_negative_normalization(n_zero[i_ch],&n_zero1,&n_zero2);
+            sum = ((__HI_SMULL(sum << n_zero1, m_zero[i_ch])) >> n_zero2) + z_out;
+% elif config.folding == "weights":
+            /* Normalize by PACT+FW (${config.out_data_t} output) */
+            sum = ((__HI_SMULL(sum << n_zero1, m_zero)) >> n_zero2) + z_out;
+% endif
+            /* Residual add */
+            sum += (__HI_SMULL(res << n_res1, m_res)) >> n_res2;
+
+            /* Store Outputs (${config.out_data_t} output) */
+% if config.out_data_t == 'u8':
+            *pOut++ = (uint8_t) __USAT(sum, 8);
+% elif config.out_data_t == 'u4':
+            if (i_el & 0x1)
+            {
+                *pOut++ |= __USAT(sum, 4) << 4;
+            }
+            else
+            {
+                *pOut = __USAT(sum, 4);
+            }
+% elif config.out_data_t == 'u2':
+            if (i_el & 0x3)
+            {
+                *pOut |= __USAT(sum, 2) << ((i_el & 0x3) << 1);
+            }
+            else
+            {
+                *pOut = __USAT(sum, 2);
+            }
+            pOut += ((i_el & 0x3) == 0x3);
+% endif
+        }
+    }
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXConv group
+ */
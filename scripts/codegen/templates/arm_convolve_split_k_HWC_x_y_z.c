@@ -0,0 +1,279 @@
+<%
+    # bits of a packed input activation
+    in_bits = {'u8': 8, 'u4': 4, 'u2': 2}[config.in_data_t]
+%>\
+${config.header_top}
+ * Description:  Mixed Precision Split-K Convolutional function that uses ${config.in_data_t}
+ *               activations, ${config.wt_data_t} weights and produce ${config.out_data_t}
+ *               output activations. Outputs are quantized using ${config.folding}
+ *               folding technique.
+${config.header_bottom}
+
+#include <assert.h>
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXConv
+ * @{
+ */
+
+  /**
+   * @brief Mixed Precision Split-K Convolution ${config.folding} (in: ${config.in_data_t}, out: ${config.out_data_t}, wt: ${config.wt_data_t})
+   *
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimension
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       left_pad    padding sizes
+   * @param[in]       right_pad   padding sizes
+   * @param[in]       top_pad     padding sizes
+   * @param[in]       bottom_pad  padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bufferA_size  number of int16_t elements available in bufferA
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       z_in        input offset
+% if config.quantization=="PACT":
+   * @param[in]       z_wt        weights offset
+% elif config.quantization=="PACT_CH":
+   * @param[in]       *z_wt       weights offset, per-output channel
+% endif
+% if config.folding=="thr":
+   * @param[in]       thresholds  pointer to thresholds
+% elif config.folding=="icn":
+   * @param[in]       z_out       output offset
+   * @param[in]       *m_zero     pointer to m zero quantization params (per-output-ch)
+   * @param[in]       *n_zero     pointer to n zero quantization params (per-output-ch)
+% else:
+   * @param[in]       z_out       output offset
+   * @param[in]       m_zero      m zero quantization param
+   * @param[in]       n_zero      n zero quantization param
+% endif
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   bufferB     pointer to buffer space for the partial sums, 2*ch_im_out int32_t (32-bit aligned)
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * The input channels are processed in chunks of ch_in_chunk channels, the largest multiple
+   * of ${config.ch_chunk_vect} dividing ch_im_in such that 2*ch_in_chunk*dim_kernel*dim_kernel <= bufferA_size.
+   * The int32_t sums of the current output pixel pair are kept in bufferB across the chunks and
+   * quantized after the last one. The weights have the same layout as the plain convolution.
+   * A single chunk is used when the whole layer fits bufferA, with no constraint on ch_im_in.
+   */
+arm_status
+${config.fn_name}(const uint8_t *Im_in,
+                    const cmixnn_dim_t dim_im_in,
+                    const cmixnn_dim_t ch_im_in,
+                    const uint8_t *wt,
+                    const cmixnn_dim_t ch_im_out,
+                    const cmixnn_dim_t dim_kernel,
+                    const uint8_t left_padding,
+                    const uint8_t right_padding,
+                    const uint8_t top_padding,
+                    const uint8_t bottom_padding,
+                    const cmixnn_dim_t stride,
+                    const cmixnn_dim_t bufferA_size,
+                    const int32_t *bias,
+                    uint8_t *Im_out,
+                    const cmixnn_dim_t dim_im_out,
+                    const uint8_t z_in,
+% if config.quantization == "PACT":
+                    const uint8_t z_wt,
+% elif config.quantization == "PACT_CH":
+                    const uint8_t *z_wt,
+% endif
+% if config.folding == "thr":
+                    const int16_t *thresholds,
+% else:
+                    const uint8_t z_out,
+%   if config.folding == "icn":
+                    const int32_t *m_zero,
+                    const int8_t *n_zero,
+%   else:
+                    const int32_t m_zero,
+                    const int8_t n_zero,
+%   endif
+% endif
+                    int16_t * bufferA,
+                    uint8_t *bufferB)
+{
+
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    cmixnn_idx_t i_out_y, i_out_x, i_ker_y, i_ker_x;
+    int16_t *pBuffer = bufferA;
+    uint8_t *pOut = Im_out;
+    int32_t *pSum = (int32_t *) bufferB;
+    const cmixnn_dim_t numCol = ch_im_in * dim_kernel * dim_kernel;
+    cmixnn_dim_t ch_in_chunk = ch_im_in;
+    int32_t i_pix, i_pix2;
+    cmixnn_dim_t i_ch, i_pair;
+
+    if (ch_im_in % ${config.ch_in_constrain} != 0 || ch_im_out % ${config.ch_out_constrain} != 0)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    if (2 * numCol > bufferA_size)
+    {
+        /* largest chunk of whole 32-bit vectors of activations and weights that fits bufferA */
+        ch_in_chunk = bufferA_size / (2 * dim_kernel * dim_kernel);
+        ch_in_chunk -= ch_in_chunk % ${config.ch_chunk_vect};
+        while (ch_in_chunk > 0 && ch_im_in % ch_in_chunk != 0)
+        {
+            ch_in_chunk -= ${config.ch_chunk_vect};
+        }
+        if (ch_in_chunk == 0)
+        {
+            /* the input channels cannot be split in chunks fitting bufferA */
+            return ARM_MATH_SIZE_MISMATCH;
+        }
+    }
+
+    /* columns of one chunk, read from the weights in segments of ch_in_chunk every ch_im_in columns */
+    const cmixnn_dim_t numColChunk = ch_in_chunk * dim_kernel * dim_kernel;
+    const cmixnn_dim_t seg_len = (ch_in_chunk == ch_im_in) ? numCol : ch_in_chunk;
+    const cmixnn_dim_t seg_stride = (ch_in_chunk == ch_im_in) ? numCol : ch_im_in;
+
+    for (i_pix = 0; i_pix < dim_im_out * dim_im_out; i_pix += 2)
+    {
+        /* the last pixel of an odd output is computed twice in place */
+        i_pix2 = (i_pix + 1 < dim_im_out * dim_im_out) ? i_pix + 1 : i_pix;
+
+        /* partial sums start from the bias */
+        for (i_ch = 0; i_ch < ch_im_out; i_ch++)
+        {
+            pSum[i_ch] = bias[i_ch];
+            pSum[ch_im_out + i_ch] = bias[i_ch];
+        }
+
+        for (i_ch = 0; i_ch < ch_im_in; i_ch += ch_in_chunk)
+        {
+            /* This part implements the im2col function over the channel chunk */
+            pBuffer = bufferA;
+            for (i_pair = 0; i_pair < 2; i_pair++)
+            {
+                i_out_y = ((i_pair == 0) ? i_pix : i_pix2) / dim_im_out;
+                i_out_x = ((i_pair == 0) ? i_pix : i_pix2) % dim_im_out;
+                if (ch_in_chunk % ${config.ch_in_vect} != 0)
+                {
+                    /* a single chunk whose pixels do not fill whole vectors: gather the packed window, padded with z_in,
+                       and convert it at once */
+                    ${config.reordered_no_shift_load_fn}(__im2col_gather(Im_in, dim_im_in, ch_im_in, ch_im_in, ${in_bits},
+                                                                i_out_y * stride - top_padding, i_out_x * stride - left_padding,
+                                                                dim_kernel, dim_kernel, 1, z_in, pBuffer, numColChunk),
+                                                pBuffer,
+                                                numColChunk,
+                                                z_in);
+                    pBuffer += numColChunk;
+                    continue;
+                }
+                for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+                {
+                    for (i_ker_x = i_out_x * stride - left_padding; i_ker_x < i_out_x * stride - left_padding + dim_kernel; i_ker_x++)
+                    {
+                        if (i_ker_y < 0 || i_ker_y >= dim_im_in || i_ker_x < 0 || i_ker_x >= dim_im_in)
+                        {
+                            memset(pBuffer, 0, sizeof(int16_t) * ch_in_chunk);
+                        }
+                        else
+                        {
+                            ${config.reordered_no_shift_load_fn}(
+% if config.in_data_t == 'u8':
+                                                Im_in + (i_ker_y * dim_im_in + i_ker_x) * ch_im_in + i_ch,
+% elif config.in_data_t == 'u4':
+                                                Im_in + (((i_ker_y * dim_im_in + i_ker_x) * ch_im_in + i_ch) >> 1),
+% elif config.in_data_t == 'u2':
+                                                Im_in + (((i_ker_y * dim_im_in + i_ker_x) * ch_im_in + i_ch) >> 2),
+% endif
+                                                pBuffer,
+                                                ch_in_chunk,
+                                                z_in);
+                        }
+                        pBuffer += ch_in_chunk;
+                    }
+                }
+            }
+
+            if (i_ch + ch_in_chunk < ch_im_in)
+            {
+                ${config.nn_mat_mul_partial_fn}(
+% if config.wt_data_t == 'u8':
+                                                wt + i_ch,
+% elif config.wt_data_t == 'u4':
+                                                wt + (i_ch >> 1),
+% elif config.wt_data_t == 'u2':
+                                                wt + (i_ch >> 2),
+% endif
+                                                bufferA,
+                                                ch_im_out,
+                                                numColChunk,
+                                                seg_len,
+                                                seg_stride,
+                                                numCol,
+                                                pSum,
+                                                z_wt);
+            }
+            else
+            {
+                /* last chunk: quantize the output pixel pair */
+% if config.out_data_t == 'u8':
+                pOut = Im_out + (i_pix) * ch_im_out;
+% elif config.out_data_t == 'u4':
+                pOut = Im_out + (((i_pix) * ch_im_out) >> 1);
+% elif config.out_data_t == 'u2':
+                pOut = Im_out + (((i_pix) * ch_im_out) >> 2);
+% endif
+                ${config.nn_mat_mul_partial_last_fn}(
+% if config.wt_data_t == 'u8':
+                                                wt + i_ch,
+% elif config.wt_data_t == 'u4':
+                                                wt + (i_ch >> 1),
+% elif config.wt_data_t == 'u2':
+                                                wt + (i_ch >> 2),
+% endif
+                                                bufferA,
+                                                ch_im_out,
+                                                numColChunk,
+                                                seg_len,
+                                                seg_stride,
+                                                numCol,
+                                                pSum,
+                                                pOut,
+                                                (i_pix2 - i_pix) * ch_im_out,
+                                                z_wt,
+% if config.folding == "thr":
+                                                thresholds);
+% else:
+                                                z_out,
+                                                m_zero,
+                                                n_zero);
+% endif
+            }
+        }
+    }
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXConv group
+ */
\ No newline at end of file
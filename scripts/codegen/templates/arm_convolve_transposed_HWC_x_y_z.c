@@ -0,0 +1,262 @@
+<%
+    # bits of a packed input activation
+    in_bits = {'u8': 8, 'u4': 4, 'u2': 2}[config.in_data_t]
+%>\
+${config.header_top}
+ * Description:  Mixed Precision Transposed Convolutional function that uses ${config.in_data_t}
+ *               activations, ${config.wt_data_t} weights and produce ${config.out_data_t}
+ *               output activations. Outputs are quantized using ${config.folding}
+ *               folding technique.
+${config.header_bottom}
+
+#include <assert.h>
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXConv
+ * @{
+ */
+
+  /**
+   * @brief Mixed Precision Transposed Convolution ${config.folding} (in: ${config.in_data_t}, out: ${config.out_data_t}, wt: ${config.wt_data_t})
+   *
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimension
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights, stored phase by phase (see details)
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       left_pad    padding sizes
+   * @param[in]       right_pad   padding sizes
+   * @param[in]       top_pad     padding sizes
+   * @param[in]       bottom_pad  padding sizes
+   * @param[in]       stride      upsampling stride
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       z_in        input offset
+% if config.quantization=="PACT":
+   * @param[in]       z_wt        weights offset
+% elif config.quantization=="PACT_CH":
+   * @param[in]       *z_wt       weights offset, per-output channel
+% endif
+% if config.folding=="thr":
+   * @param[in]       thresholds  pointer to thresholds
+% elif config.folding=="icn":
+   * @param[in]       z_out       output offset
+   * @param[in]       *m_zero     pointer to m zero quantization params (per-output-ch)
+   * @param[in]       *n_zero     pointer to n zero quantization params (per-output-ch)
+% else:
+   * @param[in]       z_out       output offset
+   * @param[in]       m_zero      m zero quantization param
+   * @param[in]       n_zero      n zero quantization param
+% endif
+   * @param[in,out]   bufferA     pointer to buffer space for input, 2*ch_im_in*ceil(dim_kernel/stride)^2 int16_t
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * Out[oy][ox] accumulates In[iy][ix] * Wt[ky][kx] for every oy = iy*stride - top_padding + ky
+   * (and likewise along x). The outputs are computed by phase: all the output pixels sharing
+   * ky0 = (oy + top_padding) % stride and kx0 = (ox + left_padding) % stride are produced by a
+   * regular convolution with the sub-kernel {ky0 + i*stride} x {kx0 + j*stride}. Hence, only
+   * the non-zero contributions are gathered and no zero-inserted input tensor is needed.
+   *
+   * The weights are stored phase by phase, with (ky0, kx0) in row-major order. Each phase holds
+   * the ch_im_out filters of its sub-kernel, laid out as [ch_im_out][i][j][ch_im_in], where i and j
+   * index the taps ky0 + i*stride and kx0 + j*stride.
+   *
+   * dim_kernel must not be smaller than stride, so that every phase has at least one tap.
+   */
+arm_status
+${config.fn_name}(const uint8_t *Im_in,
+                    const cmixnn_dim_t dim_im_in,
+                    const cmixnn_dim_t ch_im_in,
+                    const uint8_t *wt,
+                    const cmixnn_dim_t ch_im_out,
+                    const cmixnn_dim_t dim_kernel,
+                    const uint8_t left_padding,
+                    const uint8_t right_padding,
+                    const uint8_t top_padding,
+                    const uint8_t bottom_padding,
+                    const cmixnn_dim_t stride,
+                    const int32_t *bias,
+                    uint8_t *Im_out,
+                    const cmixnn_dim_t dim_im_out,
+                    const uint8_t z_in,
+% if config.quantization == "PACT":
+                    const uint8_t z_wt,
+% elif config.quantization == "PACT_CH":
+                    const uint8_t *z_wt,
+% endif
+% if config.folding == "thr":
+                    const int16_t *thresholds,
+% else:
+                    const uint8_t z_out,
+%   if config.folding == "icn":
+                    const int32_t *m_zero,
+                    const int8_t *n_zero,
+%   else:
+                    const int32_t m_zero,
+                    const int8_t n_zero,
+%   endif
+% endif
+                    int16_t * bufferA,
+                    uint8_t *bufferB)
+{
+
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    cmixnn_idx_t i_out_y, i_out_x, i_in_y, i_in_x;
+    cmixnn_idx_t ker_y0, ker_x0, i_ker_y, i_ker_x;
+    int16_t *pBuffer = bufferA;
+    uint8_t *pOut;
+    const uint8_t *wt_ph = wt;
+
+    if (ch_im_in % ${config.ch_in_constrain} != 0 || ch_im_out % ${config.ch_out_constrain} != 0 || dim_kernel < stride)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    for (ker_y0 = 0; ker_y0 < stride; ker_y0++)
+    {
+        /* taps of the phase along y and first output row using them */
+        const cmixnn_idx_t n_ker_y = (dim_kernel - ker_y0 + stride - 1) / stride;
+        const cmixnn_idx_t out_y0 = ((ker_y0 - top_padding) % stride + stride) % stride;
+
+        for (ker_x0 = 0; ker_x0 < stride; ker_x0++)
+        {
+            /* taps of the phase along x and first output column using them */
+            const cmixnn_idx_t n_ker_x = (dim_kernel - ker_x0 + stride - 1) / stride;
+            const cmixnn_idx_t out_x0 = ((ker_x0 - left_padding) % stride + stride) % stride;
+            const cmixnn_dim_t numCol = n_ker_y * n_ker_x * ch_im_in;
+
+            for (i_out_y = out_y0; i_out_y < dim_im_out; i_out_y += stride)
+            {
+                for (i_out_x = out_x0; i_out_x < dim_im_out; i_out_x += stride)
+                {
+                    if (ch_im_in % ${config.ch_in_vect} != 0)
+                    {
+                        /* pixels do not fill whole vectors: gather the packed taps of the phase, walking the input
+                           backwards and padded with z_in, and convert them at once */
+                        ${config.reordered_no_shift_load_fn}(__im2col_gather(Im_in, dim_im_in, ch_im_in, ch_im_in, ${in_bits},
+                                                                    (i_out_y + top_padding - ker_y0) / stride,
+                                                                    (i_out_x + left_padding - ker_x0) / stride,
+                                                                    n_ker_y, n_ker_x, -1, z_in, pBuffer, numCol),
+                                                    pBuffer,
+                                                    numCol,
+                                                    z_in);
+                        pBuffer += numCol;
+                    }
+                    else
+                    {
+                        /* This part implements the im2col function over the taps of the phase */
+                        for (i_ker_y = 0; i_ker_y < n_ker_y; i_ker_y++)
+                        {
+                            i_in_y = (i_out_y + top_padding - ker_y0) / stride - i_ker_y;
+                            for (i_ker_x = 0; i_ker_x < n_ker_x; i_ker_x++)
+                            {
+                                i_in_x = (i_out_x + left_padding - ker_x0) / stride - i_ker_x;
+                                if (i_in_y < 0 || i_in_y >= dim_im_in || i_in_x < 0 || i_in_x >= dim_im_in)
+                                {
+                                    memset(pBuffer, 0, sizeof(int16_t) * ch_im_in);
+                                }
+                                else
+                                {
+                                    ${config.reordered_no_shift_load_fn}(
+% if config.in_data_t == 'u8':
+                                                    Im_in + (i_in_y * dim_im_in + i_in_x) * ch_im_in,
+% elif config.in_data_t == 'u4':
+                                                    Im_in + (((i_in_y * dim_im_in + i_in_x) * ch_im_in) >> 1),
+% elif config.in_data_t == 'u2':
+                                                    Im_in + (((i_in_y * dim_im_in + i_in_x) * ch_im_in) >> 2),
+% endif
+                                                    pBuffer,
+                                                    ch_im_in,
+                                                    z_in);
+                                }
+                                pBuffer += ch_im_in;
+                            }
+                        }
+                    }
+
+                    if (pBuffer == bufferA + 2 * numCol || i_out_x + stride >= dim_im_out)
+                    {
+                        cmixnn_dim_t ch_out_stride = stride * ch_im_out;
+
+                        if (pBuffer != bufferA + 2 * numCol)
+                        {
+                            /* last pixel of the row has no partner: compute it twice in place */
+                            memcpy(pBuffer, bufferA, sizeof(int16_t) * numCol);
+                            ch_out_stride = 0;
+                        }
+                        else
+                        {
+                            /* first pixel of the pair */
+                            i_out_x -= stride;
+                        }
+
+% if config.out_data_t == 'u8':
+                        pOut = Im_out + (i_out_y * dim_im_out + i_out_x) * ch_im_out;
+% elif config.out_data_t == 'u4':
+                        pOut = Im_out + (((i_out_y * dim_im_out + i_out_x) * ch_im_out) >> 1);
+% elif config.out_data_t == 'u2':
+                        pOut = Im_out + (((i_out_y * dim_im_out + i_out_x) * ch_im_out) >> 2);
+% endif
+                        ${config.nn_mat_mul_fn}(wt_ph,
+                                                bufferA,
+                                                ch_im_out,
+                                                numCol,
+                                                bias,
+                                                pOut,
+                                                ch_out_stride,
+                                                z_wt,
+% if config.folding == "thr":
+                                                thresholds);
+% else:
+                                                z_out,
+                                                m_zero,
+                                                n_zero);
+% endif
+                        if (ch_out_stride != 0)
+                        {
+                            i_out_x += stride;
+                        }
+                        /* counter reset */
+                        pBuffer = bufferA;
+                    }
+                }
+            }
+
+            /* move to the sub-kernel of the next phase */
+% if config.wt_data_t == 'u8':
+            wt_ph += ch_im_out * numCol;
+% elif config.wt_data_t == 'u4':
+            wt_ph += ch_im_out * ((numCol + 1) >> 1);
+% elif config.wt_data_t == 'u2':
+            wt_ph += ch_im_out * ((numCol + 3) >> 2);
+% endif
+        }
+    }
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXConv group
+ */
\ No newline at end of file
@@ -1,8 +1,131 @@
+<%!
+    def packed(base, expr, data_t):
+        """pointer to the element expr of a packed tensor"""
+        if data_t == 'u8':
+            return "{0} + {1}".format(base, expr)
+        return "{0} + (({1}) >> {2})".format(base, expr, 1 if data_t == 'u4' else 2)
+
+    def get_el(ptr, data_t):
+        """element i_el of a packed tensor"""
+        if data_t == 'u8':
+            return ptr + "[i_el]"
+        if data_t == 'u4':
+            return "((" + ptr + "[i_el >> 1] >> ((i_el & 0x1) << 2)) & 0x0F)"
+        return "((" + ptr + "[i_el >> 2] >> ((i_el & 0x3) << 1)) & 0x03)"
+
+    def sat(expr, bits, signed):
+        """output saturated to bits, the signed ones masked to their field"""
+        if not signed:
+            return "__USAT({0}, {1})".format(expr, bits)
+        if bits == 8:
+            return "__SSAT({0}, 8)".format(expr)
+        return "(__SSAT({0}, {1}) & 0x{2:02X})".format(expr, bits, (1 << bits) - 1)
+%>\
+<%
+    # operands of the depthwise stage: the expanded rows in the ring buffer for the inverted residual
+    ch_dw = "ch_im_ex" if config.inverted_residual else "ch_im_in"
+    ch_dw_out = "ch_im_ex" if config.inverted_residual else "ch_im_out"
+    dw_in = "pRing" if config.inverted_residual else "Im_in"
+    dw_row = "(i_ker_y % dim_kernel)" if config.inverted_residual else "i_ker_y"
+    z_dw_in = "z_out_ex" if config.inverted_residual else "z_in"
+    # signed inputs are unpacked with their sign bits flipped, i.e. biased by half of their range
+    in_bias = {'s8': 128, 's4': 8, 's2': 2}.get(config.in_data_t)
+    if in_bias:
+        z_dw_in = "(z_in + {0})".format(in_bias)
+    out_t = config.out_data_t.replace('s', 'u')
+    # bytes of the expanded rows ring and of the depthwise output row of the inverted residual
+    if config.inverted_residual:
+        ir_buf_bytes = {'u8': "{0}", 'u4': "(({0}) >> 1)", 'u2': "(({0}) >> 2)"}[out_t].format("(dim_kernel * dim_im_in + dim_im_out) * ch_im_ex")
+%>\
+<%def name="pointwise_row(src, src_t, ch_src, z_src, n_pix, wt_, ch_dst, bias_, dst, dst_t, mm_fn, mm_strided_fn, sfx)">\
+        {
+            const uint8_t *pSrc = ${src};
+            uint8_t *pDst = ${dst};
+            int16_t *pCol = bufferA;
+            cmixnn_idx_t i_pix;
+
+            for (i_pix = 0; i_pix < ${n_pix}; i_pix++)
+            {
+                arm_${src_t}_to_int16_reordered(${packed("pSrc", "i_pix * " + ch_src, src_t)},
+                                            pCol,
+                                            ${ch_src},
+                                            ${z_src});
+                pCol += ${ch_src};
+
+                if (pCol == bufferA + 2 * ${ch_src})
+                {
+                    ${mm_fn}(${wt_},
+                                            bufferA,
+                                            ${ch_dst},
+                                            ${ch_src},
+                                            ${bias_},
+                                            pDst,
+                                            z_wt${sfx},
+% if config.folding == "thr":
+                                            thresholds${sfx});
+% else:
+                                            z_out${sfx},
+                                            m_zero${sfx},
+                                            n_zero${sfx});
+% endif
+                    pDst = ${packed("pDst", "2 * " + ch_dst, dst_t)};
+                    pCol = bufferA;
+                }
+            }
+
+            if (pCol != bufferA)
+            {
+                /* single pixel left: duplicate its column and compute it twice in place */
+                memcpy(pCol, bufferA, sizeof(int16_t) * ${ch_src});
+                ${mm_strided_fn}(${wt_},
+                                                bufferA,
+                                                ${ch_dst},
+                                                ${ch_src},
+                                                ${bias_},
+                                                pDst,
+                                                0,
+                                                z_wt${sfx},
+% if config.folding == "thr":
+                                                thresholds${sfx});
+% else:
+                                                z_out${sfx},
+                                                m_zero${sfx},
+                                                n_zero${sfx});
+% endif
+            }
+        }
+</%def>\
 ${config.header_top}
+% if config.dilated:
+ * Description:  Mixed Precision Dilated Depthwise Convolutional function
+% elif config.rows:
+ * Description:  Mixed Precision Row Range Depthwise Convolutional function
+% elif config.inverted_residual:
+ * Description:  Mixed Precision fused Inverted Residual function (expansion,
+ *               depthwise and projection convolutions and residual add)
+% elif config.fused:
+ * Description:  Mixed Precision fused Depthwise and Pointwise Convolutional function
+% else:
  * Description:  Mixed Precision Depthwise Convolutional function
+% endif
+% if config.inverted_residual:
+ *               that uses ${config.ir_in_data_t} activations, ${config.pw_wt_data_t} expansion and projection weights,
+ *               ${config.wt_data_t} depthwise weights, ${config.out_data_t} intermediate activations
+ *               and produce ${config.pw_out_data_t} output activations.
+% elif config.fused:
+ *               that uses ${config.in_data_t} activations, ${config.wt_data_t} depthwise weights,
+ *               ${config.out_data_t} intermediate activations, ${config.pw_wt_data_t} pointwise weights
+ *               and produce ${config.pw_out_data_t} output activations.
+% elif config.raw:
+ *               that uses ${config.in_data_t} activations, ${config.wt_data_t} weights
+ *               and produce the raw ${config.out_data_t} accumulators, with no requantization.
+% else:
  *               that uses ${config.in_data_t} activations, ${config.wt_data_t} weights
- *               and produce ${config.in_data_t} output activations.
+ *               and produce ${config.out_data_t} output activations.
+% endif
+% if not config.raw:
  *               Outputs are quantized using ${config.folding} folding technique.
+% endif
  ${config.header_bottom}
 
 #include <assert.h>
@@ -19,21 +142,58 @@ ${config.header_top}
  */
 
  /**
+% if config.dilated:
+   * @brief Mixed Precision Dilated Depthwise Convolutional function that uses ${config.in_data_t} activations, ${config.wt_data_t} weights
+% elif config.rows:
+   * @brief Mixed Precision Row Range Depthwise Convolutional function that uses ${config.in_data_t} activations, ${config.wt_data_t} weights
+% elif config.inverted_residual:
+   * @brief Mixed Precision fused Inverted Residual function that uses ${config.ir_in_data_t} activations, ${config.pw_wt_data_t} expansion and
+   *        projection weights, ${config.wt_data_t} depthwise weights, ${config.out_data_t} intermediate activations
+% elif config.fused:
+   * @brief Mixed Precision fused Depthwise and Pointwise Convolutional function that uses ${config.in_data_t} activations,
+   *        ${config.wt_data_t} depthwise weights, ${config.out_data_t} intermediate activations, ${config.pw_wt_data_t} pointwise weights
+% else:
    * @brief Mixed Precision Depthwise Convolutional function that uses ${config.in_data_t} activations, ${config.wt_data_t} weights
-   *        and produce ${config.in_data_t} output activations. Outputs are quantized using ${config.folding} folding technique.
+% endif
+% if config.fused:
+   *        and produce ${config.pw_out_data_t} output activations. Outputs are quantized using ${config.folding} folding technique.
+% elif config.raw:
+   *        and produce the raw ${config.out_data_t} accumulators, with no requantization.
+% else:
+   *        and produce ${config.out_data_t} output activations. Outputs are quantized using ${config.folding} folding technique.
+% endif
    *
    * @param[in]       Im_in       pointer to input tensor
    * @param[in]       dim_im_in   input tensor dimension
    * @param[in]       ch_im_in    number of input tensor channels
+% if config.inverted_residual:
+   * @param[in]       wt_ex       pointer to expansion kernel weights
+   * @param[in]       ch_im_ex    number of expansion filters, i.e., expanded channels
+   * @param[in]       bias_ex     pointer to expansion bias
+   * @param[in]       wt          pointer to depthwise kernel weights
+% else:
    * @param[in]       wt          pointer to kernel weights
    * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+% endif
    * @param[in]       dim_kernel  filter kernel size
    * @param[in]       left_pad    padding sizes
    * @param[in]       right_pad   padding sizes
    * @param[in]       top_pad     padding sizes
    * @param[in]       bottom_pad  padding sizes
    * @param[in]       stride      convolution stride
+% if config.dilated:
+   * @param[in]       dilation    kernel dilation factor
+% endif
+% if config.rows:
+   * @param[in]       out_y_begin first output row to compute
+   * @param[in]       out_y_end   output row following the last one to compute
+% endif
    * @param[in]       bias        pointer to bias
+% if config.fused:
+   * @param[in]       wt_pw       pointer to pointwise kernel weights
+   * @param[in]       ch_im_out_pw number of pointwise filters, i.e., output tensor channels
+   * @param[in]       bias_pw     pointer to pointwise bias
+% endif
    * @param[in,out]   Im_out      pointer to output tensor
    * @param[in]       dim_im_out  output tensor dimension
    * @param[in]       z_in        input offset
@@ -42,55 +202,224 @@ ${config.header_top}
 % elif config.quantization=="PACT_CH":
    * @param[in]       *z_wt       weights offset, per-output channel
 % endif
-% if config.folding=="thr":
+% if config.raw:
+%   if config.out_data_t == 'int16':
+   * @param[in]       n_zero      right shift of the accumulators, 0 to 31
+%   endif
+% elif config.folding=="thr":
    * @param[in]       thresholds  pointer to thresholds
+%   if config.fused:
+   * @param[in]       z_out       offset of the thresholded intermediate activations
+%   endif
 % elif config.folding=="icn":
    * @param[in]       z_out       output offset
    * @param[in]       m_zero      pointer to m zero quantization params (per-output-ch)
    * @param[in]       n_zero      pointer to n zero quantization params (per-output-ch)
+% elif config.folding=="pow2":
+   * @param[in]       z_out       output offset
+   * @param[in]       n_zero      right shift of the power-of-two scale, 0 to 31
 % else:
    * @param[in]       z_out       output offset
    * @param[in]       m_zero      m zero quantization param
    * @param[in]       n_zero      n zero quantization param
 % endif
+% if config.inverted_residual:
+%   if config.quantization=="PACT":
+   * @param[in]       z_wt_ex     expansion weights offset
+%   elif config.quantization=="PACT_CH":
+   * @param[in]       *z_wt_ex    expansion weights offset, per-output channel
+%   endif
+%   if config.folding=="thr":
+   * @param[in]       thresholds_ex pointer to expansion thresholds
+   * @param[in]       z_out_ex    offset of the thresholded expanded activations
+%   elif config.folding=="icn":
+   * @param[in]       z_out_ex    expansion output offset
+   * @param[in]       m_zero_ex   pointer to expansion m zero quantization params (per-output-ch)
+   * @param[in]       n_zero_ex   pointer to expansion n zero quantization params (per-output-ch)
+%   else:
+   * @param[in]       z_out_ex    expansion output offset
+   * @param[in]       m_zero_ex   expansion m zero quantization param
+   * @param[in]       n_zero_ex   expansion n zero quantization param
+%   endif
+% endif
+% if config.fused:
+%   if config.quantization=="PACT":
+   * @param[in]       z_wt_pw     pointwise weights offset
+%   elif config.quantization=="PACT_CH":
+   * @param[in]       *z_wt_pw    pointwise weights offset, per-output channel
+%   endif
+%   if config.folding=="thr":
+   * @param[in]       thresholds_pw pointer to pointwise thresholds
+%   elif config.folding=="icn":
+   * @param[in]       z_out_pw    pointwise output offset
+   * @param[in]       m_zero_pw   pointer to pointwise m zero quantization params (per-output-ch)
+   * @param[in]       n_zero_pw   pointer to pointwise n zero quantization params (per-output-ch)
+%   else:
+   * @param[in]       z_out_pw    pointwise output offset
+   * @param[in]       m_zero_pw   pointwise m zero quantization param
+   * @param[in]       n_zero_pw   pointwise n zero quantization param
+%   endif
+%   if config.inverted_residual:
+   * @param[in]       m_res       residual m quantization param, 0 for no residual add
+   * @param[in]       n_res       residual n quantization param
+   * @param[in,out]   bufferA     pointer to buffer space for input, max(dim_kernel * dim_kernel * ch_im_ex, 4 * ch_im_ex, 4 * ch_im_in) bytes
+   * @param[in,out]   bufferB     pointer to buffer space for dim_kernel rows of the expanded tensor, a row of the depthwise output and 2 * ch_im_out_pw int32_t (32-bit aligned)
+%   else:
+   * @param[in,out]   bufferA     pointer to buffer space for input, max(dim_kernel * dim_kernel * ch_im_in, 4 * ch_im_in) bytes
+   * @param[in,out]   bufferB     pointer to buffer space for a row of the depthwise output
+%   endif
+% else:
    * @param[in,out]   bufferA     pointer to buffer space for input
    * @param[in,out]   bufferB     pointer to buffer space for output
+% endif
    * @return     The function returns either
    * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+% if config.rows:
+   *
+   * @details
+   *
+   * Only the output rows [out_y_begin, out_y_end) are computed. The function keeps no state, so
+   * disjoint row ranges can be computed concurrently, each with its own bufferA.
+% elif config.inverted_residual:
+   *
+   * @details
+   *
+   * The expanded tensor is never stored in full: the input rows are expanded (1x1 convolution) only when
+   * they enter the depthwise window, into a ring of dim_kernel rows in bufferB. Each depthwise output row
+   * is then projected (1x1 convolution) into the output. The depthwise parameters (wt, bias, z_wt, z_out,
+   * m_zero, n_zero) produce the ${config.out_data_t} depthwise output; z_out_ex and z_out are the input
+   * offsets of the depthwise and of the projection stages.
+   *
+   * When m_res is not 0 (stride 1, ch_im_out_pw equal to ch_im_in), the input is added to the output:
+   * out = requant(projection) + requant(Im_in - z_in), with (m_res, n_res) the scale of the input
+   * relative to the output. The projection sums are kept in int32_t in bufferB and requantized
+   * together with the input, so that the output is saturated once, after the residual add.
+   *
+   * <b>Constraints</b>: ch_im_in multiple of ${config.ch_in_constrain}, ch_im_ex multiple of ${config.ch_ex_constrain}, ch_im_out_pw multiple of ${config.ch_out_constrain}.
+% elif config.fused:
+   *
+   * @details
+   *
+   * The depthwise output is produced one row at a time into bufferB and immediately consumed by the
+   * pointwise (1x1) convolution, so it is never stored in full. The depthwise parameters (wt, bias,
+   * z_wt, z_out, m_zero, n_zero) produce the ${config.out_data_t} intermediate activations; z_out is
+   * the input offset of the pointwise stage.
+   *
+   * <b>Constraints</b>: ch_im_in multiple of ${config.ch_in_constrain}, ch_im_out_pw multiple of ${config.ch_out_constrain}.
+% endif
+% if config.in_signed or config.out_signed:
+   *
+   * The ${" and ".join(n for n, s in (("input", config.in_signed), ("output", config.out_signed)) if s)} activations are signed (two's complement), with signed offsets.
+% endif
+% if config.wt_data_t != 'u8':
+   *
+   * The packed weights of every tap start on a byte: ${ch_dw} must be a multiple of ${2 if config.wt_data_t == 'u4' else 4}.
+% endif
    */
 
 arm_status
 ${config.fn_name}(const uint8_t * Im_in,
-                        const uint16_t dim_im_in,
-                        const uint16_t ch_im_in,
+                        const cmixnn_dim_t dim_im_in,
+                        const cmixnn_dim_t ch_im_in,
+% if config.inverted_residual:
+                        const uint8_t * wt_ex,
+                        const cmixnn_dim_t ch_im_ex,
+                        const int32_t * bias_ex,
+                        const uint8_t * wt,
+% else:
                         const uint8_t * wt,
-                        const uint16_t ch_im_out,
-                        const uint16_t dim_kernel,
+                        const cmixnn_dim_t ch_im_out,
+% endif
+                        const cmixnn_dim_t dim_kernel,
                         const uint8_t left_padding,
                         const uint8_t right_padding,
                         const uint8_t top_padding,
                         const uint8_t bottom_padding,
-                        const uint16_t stride,
+                        const cmixnn_dim_t stride,
+% if config.dilated:
+                        const cmixnn_dim_t dilation,
+% endif
+% if config.rows:
+                        const cmixnn_dim_t out_y_begin,
+                        const cmixnn_dim_t out_y_end,
+% endif
                         const int32_t * bias,
-                        uint8_t * Im_out,
-                        const uint16_t dim_im_out,
-                        const uint8_t z_in,
+% if config.fused:
+                        const uint8_t * wt_pw,
+                        const cmixnn_dim_t ch_im_out_pw,
+                        const int32_t * bias_pw,
+% endif
+                        ${config.out_ptr_t} * Im_out,
+                        const cmixnn_dim_t dim_im_out,
+                        const ${config.z_in_t} z_in,
+% if config.inverted_residual:
+%   if config.quantization=="PACT":
+                        const uint8_t z_wt_ex,
+%   elif config.quantization=="PACT_CH":
+                        const uint8_t *z_wt_ex,
+%   endif
+%   if config.folding=="thr":
+                        const int16_t * thresholds_ex,
+                        const uint8_t z_out_ex,
+%   else:
+                        const uint8_t z_out_ex,
+%     if config.folding=="icn":
+                        const int32_t *m_zero_ex,
+                        const int8_t *n_zero_ex,
+%     else:
+                        const int32_t m_zero_ex,
+                        const int8_t n_zero_ex,
+%     endif
+%   endif
+% endif
 % if config.quantization=="PACT":
                         const uint8_t z_wt,
 % elif config.quantization=="PACT_CH":
                         const uint8_t *z_wt,
 % endif
-% if config.folding=="thr":
+% if config.raw:
+%   if config.out_data_t == 'int16':
+                        const int8_t n_zero,
+%   endif
+% elif config.folding=="thr":
                         const int16_t * thresholds,
-% else:
+%   if config.fused:
                         const uint8_t z_out,
+%   endif
+% else:
+                        const ${config.z_out_t} z_out,
 %   if config.folding=="icn":
                         const int32_t *m_zero,
                         const int8_t *n_zero,
+%   elif config.folding=="pow2":
+                        const int8_t n_zero,
 %   else:
                         const int32_t m_zero,
                         const int8_t n_zero,
 %   endif
+% endif
+% if config.fused:
+%   if config.quantization=="PACT":
+                        const uint8_t z_wt_pw,
+%   elif config.quantization=="PACT_CH":
+                        const uint8_t *z_wt_pw,
+%   endif
+%   if config.folding=="thr":
+                        const int16_t * thresholds_pw,
+%   else:
+                        const uint8_t z_out_pw,
+%     if config.folding=="icn":
+                        const int32_t *m_zero_pw,
+                        const int8_t *n_zero_pw,
+%     else:
+                        const int32_t m_zero_pw,
+                        const int8_t n_zero_pw,
+%     endif
+%   endif
+% endif
+% if config.inverted_residual:
+                        const int32_t m_res,
+                        const int8_t n_res,
 % endif
                         int16_t * bufferA,
                         uint8_t * bufferB)
@@ -99,14 +428,18 @@ ${config.fn_name}(const uint8_t * Im_in,
 #if defined (ARM_MATH_DSP)
     /* Run the following code for Cortex-M4 and Cortex-M7 */
 
-    int16_t   i_out_y, i_out_x;
-    int16_t   i_ker_y, i_ker_x;
+    cmixnn_idx_t   i_out_y, i_out_x;
+    cmixnn_idx_t   i_ker_y, i_ker_x;
     uint8_t    *colBuffer = (uint8_t *) bufferA;
     uint8_t    *pBuffer = colBuffer;
     const int32_t *pBias = bias;
-    uint8_t   *pOut = Im_out;
-    uint16_t  rowCnt;
-    uint16_t  row_shift;
+    ${config.out_ptr_t}   *pOut = Im_out;
+    cmixnn_dim_t  rowCnt;
+    cmixnn_dim_t  row_shift;
+% if config.dilated:
+    /* spatial extent of the dilated kernel */
+    const cmixnn_idx_t dim_kernel_dil = (dim_kernel - 1) * dilation + 1;
+% endif
 
 % if config.quantization=="PACT":
     int16_t Vz_wt[2] = {z_wt,z_wt};
@@ -114,7 +447,7 @@ ${config.fn_name}(const uint8_t * Im_in,
     int32_t inz_wt = *__SIMD32(pz_wt);
 % endif
 
-    int16_t Vz_in[2] = {z_in,z_in};
+    int16_t Vz_in[2] = {${z_dw_in},${z_dw_in}};
     const int32_t *pz_in = (int32_t *) Vz_in;
     int32_t inz_in = *__SIMD32(pz_in);
 
@@ -127,60 +460,185 @@ ${config.fn_name}(const uint8_t * Im_in,
     /* Negative N_ZERO Normalization */
     int8_t n_zero1;
     int8_t n_zero2;
+% elif config.folding == "pow2":
+    /* Rounding of the power-of-two scale */
+    const int32_t n_round = (int32_t) ((1u << n_zero) >> 1);
+% elif config.out_data_t == "int16":
+    /* Rounding of the accumulator shift */
+    const int32_t n_round = (int32_t) ((1u << n_zero) >> 1);
 % endif
 
+% if config.wt_data_t != 'u8':
+    if (${ch_dw} % ${2 if config.wt_data_t == 'u4' else 4} != 0)
+    {
+        /* the taps of the packed weights start on a byte */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+% endif
+% if config.inverted_residual:
+    if (ch_im_in % ${config.ch_in_constrain} != 0 || ch_im_ex % ${config.ch_ex_constrain} != 0 || ch_im_out_pw % ${config.ch_out_constrain} != 0)
+    {
+        /* check if the pointwise dimensions meet the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    if (m_res != 0 && (ch_im_in != ch_im_out_pw || dim_im_in != dim_im_out || stride != 1))
+    {
+        /* the residual add needs the input and the output to have the same shape */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    /* ring of the dim_kernel expanded rows read by the depthwise window, followed by the depthwise output row */
+    uint8_t *pRing = bufferB;
+    uint8_t *pRow = ${packed("bufferB", "dim_kernel * dim_im_in * ch_im_ex", config.out_data_t)};
+    /* int32_t sums of a projected pixel pair, after the depthwise output row (32-bit aligned) */
+    int32_t *pSum = (int32_t *) (bufferB + ((${ir_buf_bytes} + 3) & ~0x3));
+    cmixnn_idx_t i_ex_y = 0;
+%   if config.folding == "weights":
+    int8_t n_zero_pw1, n_zero_pw2;
+%   endif
+    int8_t n_res1, n_res2;
+
+%   if config.folding == "weights":
+    __n_zero_negative_normalization(n_zero_pw, &n_zero_pw1, &n_zero_pw2);
+%   endif
+    __n_zero_negative_normalization(n_res, &n_res1, &n_res2);
+% else:
     /* do some checking here, basically ch_im_in == ch_im_out */
     if (ch_im_in != ch_im_out)
     {
         return ARM_MATH_SIZE_MISMATCH;
     }
 
+%   if config.fused:
+    if (ch_im_in % ${config.ch_in_constrain} != 0 || ch_im_out_pw % ${config.ch_out_constrain} != 0)
+    {
+        /* check if the pointwise dimensions meet the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    /* the depthwise output row */
+    uint8_t *pRow = bufferB;
+%   endif
+% endif
+
+% if config.rows:
+    if (out_y_begin > out_y_end || out_y_end > dim_im_out)
+    {
+        /* check if the output rows lie in the output tensor */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    /* first pixel of the output rows computed by this call */
+%   if config.out_data_t=='u8':
+    pOut = Im_out + out_y_begin * dim_im_out * ${ch_dw_out};
+%   elif config.out_data_t=='u4':
+    pOut = Im_out + ((out_y_begin * dim_im_out * ${ch_dw_out}) >> 1);
+%   elif config.out_data_t=='u2':
+    pOut = Im_out + ((out_y_begin * dim_im_out * ${ch_dw_out}) >> 2);
+%   endif
+
+    for (i_out_y = out_y_begin; i_out_y < out_y_end; i_out_y++)
+% else:
     for (i_out_y = 0; i_out_y < dim_im_out; i_out_y++)
+% endif
     {
+% if config.inverted_residual:
+        /* expand the input rows entering the depthwise window, each one once */
+        i_ex_y = (i_ex_y < i_out_y * stride - top_padding) ? i_out_y * stride - top_padding : i_ex_y;
+        for (; i_ex_y < i_out_y * stride - top_padding + dim_kernel && i_ex_y < dim_im_in; i_ex_y++)
+${pointwise_row(packed("Im_in", "i_ex_y * dim_im_in * ch_im_in", config.ir_in_data_t), config.ir_in_data_t, "ch_im_in", "z_in", "dim_im_in",
+                "wt_ex", "ch_im_ex", "bias_ex", packed("pRing", "(i_ex_y % dim_kernel) * dim_im_in * ch_im_ex", config.out_data_t),
+                config.out_data_t, config.nn_mat_mul_ex_fn, config.nn_mat_mul_strided_ex_fn, "_ex")}\
+
+% endif
+% if config.fused:
+        /* the depthwise output row is stored in pRow */
+        pOut = pRow;
+
+% endif
         for (i_out_x = 0; i_out_x < dim_im_out; i_out_x++)
         {
             /* we first do im2col here */
+% if config.dilated:
+            for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel_dil; i_ker_y += dilation)
+            {
+                for (i_ker_x = i_out_x * stride - left_padding; i_ker_x < i_out_x * stride - left_padding + dim_kernel_dil; i_ker_x += dilation)
+                {
+% else:
             for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
             {
                 for (i_ker_x = i_out_x * stride - left_padding; i_ker_x < i_out_x * stride - left_padding + dim_kernel; i_ker_x++)
                 {
+% endif
                     if (i_ker_y < 0 || i_ker_y >= dim_im_in || i_ker_x < 0 || i_ker_x >= dim_im_in)
                     {
-                        memset(pBuffer, 0, ch_im_in);
+% if in_bias:
+                        /* the padding is the zero of the signed input, with its sign bit flipped */
+% endif
+                        memset(pBuffer, ${in_bias or 0}, ${ch_dw});
                     }
                     else
                     {
 % if config.in_data_t=='u8':
-                        memcpy(pBuffer, Im_in + (i_ker_y * dim_im_in + i_ker_x) * ch_im_in, ch_im_in);
+                        memcpy(pBuffer, ${dw_in} + (${dw_row} * dim_im_in + i_ker_x) * ${ch_dw}, ${ch_dw});
 % elif config.in_data_t=='u4':
                         /* Unpack Input uint4_t to uint8_t */
-                        const uint8_t *Im_in2 =  Im_in + (i_ker_y * (dim_im_in) + i_ker_x) * (ch_im_in>>1);
-                        for(int j=0, jj=0; j<ch_im_in>>1; j++)
+                        const uint8_t *Im_in2 =  ${dw_in} + (${dw_row} * (dim_im_in) + i_ker_x) * (${ch_dw}>>1);
+                        for(int j=0, jj=0; j<${ch_dw}>>1; j++)
                         {
                             pBuffer[jj++] =  Im_in2[j]       & 0x0F;
                             pBuffer[jj++] = (Im_in2[j] >> 4) & 0x0F;
                         }
 % elif config.in_data_t=='u2':
                         /* Unpack Input uint4_t to uint8_t */
-                        const uint8_t *Im_in2 =  Im_in + (i_ker_y * (dim_im_in) + i_ker_x) * (ch_im_in>>2);
-                        for(int j=0, jj=0; j<ch_im_in>>2; j++)
+                        const uint8_t *Im_in2 =  ${dw_in} + (${dw_row} * (dim_im_in) + i_ker_x) * (${ch_dw}>>2);
+                        for(int j=0, jj=0; j<${ch_dw}>>2; j++)
                         {
                             pBuffer[jj++] =  Im_in2[j]       & 0x03;
                             pBuffer[jj++] = (Im_in2[j] >> 2) & 0x03;
                             pBuffer[jj++] = (Im_in2[j] >> 4) & 0x03;
                             pBuffer[jj++] = (Im_in2[j] >> 6) & 0x03;
                         }
+% elif config.in_data_t=='s8':
+                        /* Flip the sign bits of the int8_t Input */
+                        const uint8_t *Im_in2 =  ${dw_in} + (${dw_row} * dim_im_in + i_ker_x) * ${ch_dw};
+                        for(int j=0; j<${ch_dw}; j++)
+                        {
+                            pBuffer[j] = Im_in2[j] ^ 0x80;
+                        }
+% elif config.in_data_t=='s4':
+                        /* Unpack Input int4_t to uint8_t, flipping the sign bits */
+                        const uint8_t *Im_in2 =  ${dw_in} + (${dw_row} * (dim_im_in) + i_ker_x) * (${ch_dw}>>1);
+                        for(int j=0, jj=0; j<${ch_dw}>>1; j++)
+                        {
+                            const uint8_t in = Im_in2[j] ^ 0x88;
+                            pBuffer[jj++] =  in       & 0x0F;
+                            pBuffer[jj++] = (in >> 4) & 0x0F;
+                        }
+% elif config.in_data_t=='s2':
+                        /* Unpack Input int2_t to uint8_t, flipping the sign bits */
+                        const uint8_t *Im_in2 =  ${dw_in} + (${dw_row} * (dim_im_in) + i_ker_x) * (${ch_dw}>>2);
+                        for(int j=0, jj=0; j<${ch_dw}>>2; j++)
+                        {
+                            const uint8_t in = Im_in2[j] ^ 0xAA;
+                            pBuffer[jj++] =  in       & 0x03;
+                            pBuffer[jj++] = (in >> 2) & 0x03;
+                            pBuffer[jj++] = (in >> 4) & 0x03;
+                            pBuffer[jj++] = (in >> 6) & 0x03;
+                        }
 % endif
                     }
-                    pBuffer += ch_im_in;
+                    pBuffer += ${ch_dw};
                 }
             }
 
             /* we will do the computation here for each channel */
-            rowCnt = ch_im_out >> 2;
+            rowCnt = ${ch_dw_out} >> 2;
             row_shift = 0;
             pBias = bias;
-% if config.quantization=="PACT_CH" or config.folding!="weights":
+% if config.quantization=="PACT_CH" or config.folding in ("icn", "thr"):
             int32_t ch_out_id=0;
 % endif
 
@@ -191,9 +649,15 @@ ${config.fn_name}(const uint8_t * Im_in,
                 int32_t     sum3 = *pBias++;
                 int32_t     sum4 = *pBias++;
 
-                uint16_t    colCnt = (dim_kernel * dim_kernel) >> 1;
+                cmixnn_dim_t    colCnt = (dim_kernel * dim_kernel) >> 1;
                 uint8_t     *pB = colBuffer + row_shift;
+% if config.wt_data_t=='u8':
                 const uint8_t *pA = wt + row_shift;
+% elif config.wt_data_t=='u4':
+                const uint8_t *pA = wt + (row_shift >> 1);
+% elif config.wt_data_t=='u2':
+                const uint8_t *pA = wt + (row_shift >> 2);
+% endif
 
 #ifndef ARM_MATH_BIG_ENDIAN
 
@@ -210,17 +674,17 @@ ${config.fn_name}(const uint8_t * Im_in,
 % endif
 
                     inB1 = *__SIMD32(pB);
-                    pB += ch_im_in;
+                    pB += ${ch_dw};
                     opB = *__SIMD32(pB);
-                    pB += ch_im_in;
+                    pB += ${ch_dw};
                     inB2 = __PKHTB(opB, inB1, 16);
                     inB1 = __PKHBT(inB1, opB, 16);
 
 % if config.wt_data_t=='u8':
                     inA1 = *__SIMD32(pA);
-                    pA += ch_im_in;
+                    pA += ${ch_dw};
                     opB = *__SIMD32(pA);
-                    pA += ch_im_in;
+                    pA += ${ch_dw};
                     inA2 = __PKHTB(opB, inA1, 16);
                     inA1 = __PKHBT(inA1, opB, 16);
 
@@ -269,14 +733,14 @@ ${config.fn_name}(const uint8_t * Im_in,
                     sum4 = __SMLAD(opA, opB, sum4);
 % elif config.wt_data_t=='u4':
                     uint32_t tmp_inA1  = (uint32_t) *((uint16_t *)pA); //ch 0, ch1 | ch2, ch3
-                    pA+=ch_im_in>>1;
+                    pA+=${ch_dw}>>1;
                     uint32_t tmp_inA2 = (uint32_t) *((uint16_t *)pA); //ch 0', ch1' | ch2', ch3'
-                    pA+=ch_im_in>>1;
+                    pA+=${ch_dw}>>1;
 
-                    inA1 = __USAT(tmp_inA1, 4) | (__USAT(tmp_inA2, 4) << 16);
-                    inA2 = __USAT(__ROR(tmp_inA1, 4), 4) | (__USAT(__ROR(tmp_inA2, 4), 4) << 16);
-                    inA3 = __USAT(__ROR(tmp_inA1, 8), 4) | (__USAT(__ROR(tmp_inA2, 8), 4) << 16);
-                    inA4 = __USAT(__ROR(tmp_inA1, 12), 4) | (__USAT(__ROR(tmp_inA2, 12), 4) << 16);
+                    inA1 = (tmp_inA1 & 0x0F) | ((tmp_inA2 & 0x0F) << 16);
+                    inA2 = ((tmp_inA1 >> 4) & 0x0F) | (((tmp_inA2 >> 4) & 0x0F) << 16);
+                    inA3 = ((tmp_inA1 >> 8) & 0x0F) | (((tmp_inA2 >> 8) & 0x0F) << 16);
+                    inA4 = ((tmp_inA1 >> 12) & 0x0F) | (((tmp_inA2 >> 12) & 0x0F) << 16);
 
                     //sum
                     opA = __UXTB16(inA1);
@@ -323,14 +787,14 @@ ${config.fn_name}(const uint8_t * Im_in,
                     sum4 = __SMLAD(opA, opB, sum4);
 % elif config.wt_data_t=='u2':
                     uint32_t tmp_inA1  = (uint32_t) *pA; //ch 0, ch1, ch2, ch3 | ...
-                    pA+=ch_im_in>>2;
+                    pA+=${ch_dw}>>2;
                     uint32_t tmp_inA2 = (uint32_t) *pA; //ch 0', ch1', ch2', ch3' | ...
-                    pA+=ch_im_in>>2;
+                    pA+=${ch_dw}>>2;
 
-                    inA1 = __USAT(tmp_inA1, 2) | (__USAT(tmp_inA2, 2) << 16);
-                    inA2 = __USAT(__ROR(tmp_inA1, 2), 2) | (__USAT(__ROR(tmp_inA2, 2), 2) << 16);
-                    inA3 = __USAT(__ROR(tmp_inA1, 4), 2) | (__USAT(__ROR(tmp_inA2, 4), 2) << 16);
-                    inA4 = __USAT(__ROR(tmp_inA1, 6), 2) | (__USAT(__ROR(tmp_inA2, 6), 2) << 16);
+                    inA1 = (tmp_inA1 & 0x03) | ((tmp_inA2 & 0x03) << 16);
+                    inA2 = ((tmp_inA1 >> 2) & 0x03) | (((tmp_inA2 >> 2) & 0x03) << 16);
+                    inA3 = ((tmp_inA1 >> 4) & 0x03) | (((tmp_inA2 >> 4) & 0x03) << 16);
+                    inA4 = ((tmp_inA1 >> 6) & 0x03) | (((tmp_inA2 >> 6) & 0x03) << 16);
 
                     //sum
                     opA = __UXTB16(inA1);
@@ -388,34 +852,34 @@ ${config.fn_name}(const uint8_t * Im_in,
                     union arm_nnword inA, inB;
 % if config.wt_data_t=='u8':
                     inA.word = *__SIMD32(pA);
-                    pA += ch_im_in;
+                    pA += ${ch_dw};
 % elif config.wt_data_t=='u4':
                     uint32_t tmp_inA = (uint32_t) *((uint16_t *)pA); //ch 0', ch1' | ch2', ch3'
-                    pA += ch_im_in>>1;
-                    inA.bytes[0] = (uint8_t) __USAT(tmp_inA, 4);
-                    inA.bytes[1] = (uint8_t) __USAT(__ROR(tmp_inA, 4), 4);
-                    inA.bytes[2] = (uint8_t) __USAT(__ROR(tmp_inA, 8), 4);
-                    inA.bytes[3] = (uint8_t) __USAT(__ROR(tmp_inA, 12), 4);
+                    pA += ${ch_dw}>>1;
+                    inA.bytes[0] = (uint8_t) (tmp_inA & 0x0F);
+                    inA.bytes[1] = (uint8_t) ((tmp_inA >> 4) & 0x0F);
+                    inA.bytes[2] = (uint8_t) ((tmp_inA >> 8) & 0x0F);
+                    inA.bytes[3] = (uint8_t) ((tmp_inA >> 12) & 0x0F);
 % elif config.wt_data_t=='u2':
                    uint32_t tmp_inA = (uint32_t) *pA; //ch 0', ch1' | ch2', ch3'
-                    pA += ch_im_in>>2;
-                    inA.bytes[0] = (uint8_t) __USAT(tmp_inA, 2);
-                    inA.bytes[1] = (uint8_t) __USAT(__ROR(tmp_inA, 2), 2);
-                    inA.bytes[2] = (uint8_t) __USAT(__ROR(tmp_inA, 4), 2);
-                    inA.bytes[3] = (uint8_t) __USAT(__ROR(tmp_inA, 6), 2);
+                    pA += ${ch_dw}>>2;
+                    inA.bytes[0] = (uint8_t) (tmp_inA & 0x03);
+                    inA.bytes[1] = (uint8_t) ((tmp_inA >> 2) & 0x03);
+                    inA.bytes[2] = (uint8_t) ((tmp_inA >> 4) & 0x03);
+                    inA.bytes[3] = (uint8_t) ((tmp_inA >> 6) & 0x03);
 % endif
                     inB.word = *__SIMD32(pB);
-                    pB += ch_im_in;
+                    pB += ${ch_dw};
 % if config.quantization=="PACT_CH":
-                    sum  += (((uint8_t) inA.bytes[0])-z_wt[ch_out_id]) * (((uint8_t) inB.bytes[0])-z_in);
-                    sum2 += (((uint8_t) inA.bytes[1])-z_wt[ch_out_id+1]) * (((uint8_t) inB.bytes[1])-z_in);
-                    sum3 += (((uint8_t) inA.bytes[2])-z_wt[ch_out_id+2]) * (((uint8_t) inB.bytes[2])-z_in);
-                    sum4 += (((uint8_t) inA.bytes[3])-z_wt[ch_out_id+3]) * (((uint8_t) inB.bytes[3])-z_in);
+                    sum  += (((uint8_t) inA.bytes[0])-z_wt[ch_out_id]) * (((uint8_t) inB.bytes[0])-${z_dw_in});
+                    sum2 += (((uint8_t) inA.bytes[1])-z_wt[ch_out_id+1]) * (((uint8_t) inB.bytes[1])-${z_dw_in});
+                    sum3 += (((uint8_t) inA.bytes[2])-z_wt[ch_out_id+2]) * (((uint8_t) inB.bytes[2])-${z_dw_in});
+                    sum4 += (((uint8_t) inA.bytes[3])-z_wt[ch_out_id+3]) * (((uint8_t) inB.bytes[3])-${z_dw_in});
 % else:
-                    sum  += (((uint8_t) inA.bytes[0])-z_wt) * (((uint8_t) inB.bytes[0])-z_in);
-                    sum2 += (((uint8_t) inA.bytes[1])-z_wt) * (((uint8_t) inB.bytes[1])-z_in);
-                    sum3 += (((uint8_t) inA.bytes[2])-z_wt) * (((uint8_t) inB.bytes[2])-z_in);
-                    sum4 += (((uint8_t) inA.bytes[3])-z_wt) * (((uint8_t) inB.bytes[3])-z_in);
+                    sum  += (((uint8_t) inA.bytes[0])-z_wt) * (((uint8_t) inB.bytes[0])-${z_dw_in});
+                    sum2 += (((uint8_t) inA.bytes[1])-z_wt) * (((uint8_t) inB.bytes[1])-${z_dw_in});
+                    sum3 += (((uint8_t) inA.bytes[2])-z_wt) * (((uint8_t) inB.bytes[2])-${z_dw_in});
+                    sum4 += (((uint8_t) inA.bytes[3])-z_wt) * (((uint8_t) inB.bytes[3])-${z_dw_in});
 % endif
                     colCnt--;
                 }
@@ -451,105 +915,84 @@ ${config.fn_name}(const uint8_t * Im_in,
                 sum2 = ((__HI_SMULL(sum2 << n_zero1,m_zero)) >> n_zero2) + z_out;
                 sum3 = ((__HI_SMULL(sum3 << n_zero1,m_zero)) >> n_zero2) + z_out;
                 sum4 = ((__HI_SMULL(sum4 << n_zero1,m_zero)) >> n_zero2) + z_out;
+% elif config.folding=="pow2":
+                /* Normalize by a rounding shift (${config.out_data_t} output) */
+                sum  = ((sum + n_round) >> n_zero) + z_out;
+                sum2 = ((sum2 + n_round) >> n_zero) + z_out;
+                sum3 = ((sum3 + n_round) >> n_zero) + z_out;
+                sum4 = ((sum4 + n_round) >> n_zero) + z_out;
+% elif config.quantization=="PACT_CH":
+                /* next per-channel weights offsets */
+                ch_out_id += 4;
 % endif
 
                 /* Store Outputs (${config.out_data_t} output) */
-% if config.out_data_t=='u8':
-                *pOut++ = (uint8_t) __USAT(sum, 8);
-                *pOut++ = (uint8_t) __USAT(sum2, 8);
-                *pOut++ = (uint8_t) __USAT(sum3, 8);
-                *pOut++ = (uint8_t) __USAT(sum4, 8);
-% elif config.out_data_t=='u4':
-                *pOut++ = ( __USAT(sum, 4) ) | ( __USAT(sum2, 4) << 4 );
-                *pOut++ = ( __USAT(sum3, 4)) | ( __USAT(sum4, 4) << 4 );
-% elif config.out_data_t=='u2':
-                *pOut++ = ( __USAT(sum,2)) | ( __USAT(sum2,2) << 2 ) | ( __USAT(sum3,2) << 4 ) | ( __USAT(sum4,2) << 6 );
+% if config.out_data_t=='int32':
+                *pOut++ = sum;
+                *pOut++ = sum2;
+                *pOut++ = sum3;
+                *pOut++ = sum4;
+% elif config.out_data_t=='int16':
+                *pOut++ = (int16_t) __SSAT((sum + n_round) >> n_zero, 16);
+                *pOut++ = (int16_t) __SSAT((sum2 + n_round) >> n_zero, 16);
+                *pOut++ = (int16_t) __SSAT((sum3 + n_round) >> n_zero, 16);
+                *pOut++ = (int16_t) __SSAT((sum4 + n_round) >> n_zero, 16);
+% elif out_t=='u8':
+                *pOut++ = (uint8_t) ${sat("sum", 8, config.out_signed)};
+                *pOut++ = (uint8_t) ${sat("sum2", 8, config.out_signed)};
+                *pOut++ = (uint8_t) ${sat("sum3", 8, config.out_signed)};
+                *pOut++ = (uint8_t) ${sat("sum4", 8, config.out_signed)};
+% elif out_t=='u4':
+                *pOut++ = ( ${sat("sum", 4, config.out_signed)} ) | ( ${sat("sum2", 4, config.out_signed)} << 4 );
+                *pOut++ = ( ${sat("sum3", 4, config.out_signed)}) | ( ${sat("sum4", 4, config.out_signed)} << 4 );
+% elif out_t=='u2':
+                *pOut++ = ( ${sat("sum", 2, config.out_signed)}) | ( ${sat("sum2", 2, config.out_signed)} << 2 ) | ( ${sat("sum3", 2, config.out_signed)} << 4 ) | ( ${sat("sum4", 2, config.out_signed)} << 6 );
 % endif
 
-% if config.wt_data_t=='u8':
                 row_shift += 4;
-% elif config.wt_data_t=='u4':
-                row_shift += 2;
-% elif config.wt_data_t=='u2':
-                row_shift += 1;
-% endif
                 rowCnt--;
             }
 
-% if config.wt_data_t=='u4':
-            int row_per_byte = 2;
-            int row_shift_wt = row_shift;
-% elif config.wt_data_t=='u2':
-            int row_per_byte = 4;
-            int row_shift_wt = row_shift;
-% endif
-
-% if config.out_data_t=='u4':
+% if out_t=='u4':
             int row_per_byte_out = 2;
-% elif config.out_data_t=='u2':
+% elif out_t=='u2':
             int row_per_byte_out = 4;
 % endif
-            rowCnt = ch_im_out & 0x3;
+            rowCnt = ${ch_dw_out} & 0x3;
             while (rowCnt)
             {
                 uint8_t     *pB = colBuffer + row_shift;
                 int32_t     sum = *pBias++;
-                uint16_t  colCnt = (dim_kernel * dim_kernel);
+                cmixnn_dim_t  colCnt = (dim_kernel * dim_kernel);
 
 % if config.wt_data_t=='u8':
                 const uint8_t *pA = wt + row_shift;
-                row_shift += 1;
-% elif config.wt_data_t=='u4':
-                const uint8_t *pA = wt + row_shift_wt;
-% elif config.wt_data_t=='u2':
-                const uint8_t *pA = wt + row_shift_wt;
+% else:
+                /* packed weight of the channel in the current tap */
+                int32_t i_wt = row_shift;
 % endif
 
                 while (colCnt)
                 {
-                    uint8_t B1 = *pB;
+                    int16_t B1 = *pB;
 % if config.wt_data_t=='u8':
-                    uint8_t A1 = (uint8_t) __USAT(*pA, 8);
-                    pA += ch_im_in;
+                    int16_t A1 = (uint8_t) __USAT(*pA, 8);
+                    pA += ${ch_dw};
 % elif config.wt_data_t=='u4':
-                    uint8_t A1;
-                    switch(row_per_byte)
-                    {
-                        case 2:
-                            A1 = (uint8_t) __USAT(*pA, 4);
-                            break;
-                        case 1:
-                            A1 = (uint8_t) __USAT(__ROR(*pA, 4), 4);
-                            break;
-                    }
-                    pA += ch_im_in>>1;
+                    int16_t A1 = (wt[i_wt >> 1] >> ((i_wt & 0x1) << 2)) & 0x0F;
+                    i_wt += ${ch_dw};
 % elif config.wt_data_t=='u2':
-                    uint8_t A1;
-                    switch(row_per_byte)
-                    {
-                        case 4:
-                            A1 = (uint8_t) __USAT(*pA, 2);
-                            break;
-                        case 3:
-                            A1 = (uint8_t) __USAT(__ROR(*pA, 2), 2);
-                            break;
-                        case 2:
-                            A1 = (uint8_t) __USAT(__ROR(*pA, 2), 4);
-                            break;
-                        case 1:
-                            A1 = (uint8_t) __USAT(__ROR(*pA, 2), 6);
-                            break;
-                    }
-                    pA += ch_im_in>>1;
+                    int16_t A1 = (wt[i_wt >> 2] >> ((i_wt & 0x3) << 1)) & 0x03;
+                    i_wt += ${ch_dw};
 % endif
-                    pB += ch_im_in;
+                    pB += ${ch_dw};
 
 % if config.quantization=="PACT":
                     A1 -= z_wt;
 % else:
                     A1 -= z_wt[ch_out_id];
 % endif
-                    B1 -= z_in;
+                    B1 -= ${z_dw_in};
                     sum += A1 * B1;
 
                     colCnt--;
@@ -571,60 +1014,155 @@ ${config.fn_name}(const uint8_t * Im_in,
 % elif config.folding=="weights":
                 /* Normalize by PACT+FW (${config.out_data_t} output) */
                 sum  = ((__HI_SMULL(sum << n_zero1,m_zero)) >> n_zero2) + z_out;
+% elif config.folding=="pow2":
+                /* Normalize by a rounding shift (${config.out_data_t} output) */
+                sum  = ((sum + n_round) >> n_zero) + z_out;
+% elif config.quantization=="PACT_CH":
+                /* next per-channel weights offset */
+                ch_out_id++;
 % endif
 
                 /* Store Outputs (${config.out_data_t} output) */
-% if config.out_data_t=='u8':
-                *pOut++ = (uint8_t) __USAT(sum, 8);
-% elif config.out_data_t=='u4':
+% if config.out_data_t=='int32':
+                *pOut++ = sum;
+% elif config.out_data_t=='int16':
+                *pOut++ = (int16_t) __SSAT((sum + n_round) >> n_zero, 16);
+% elif out_t=='u8':
+                *pOut++ = (uint8_t) ${sat("sum", 8, config.out_signed)};
+% elif out_t=='u4':
                 switch(row_per_byte_out){
                     case 2:
-                        *pOut  = ( __USAT(sum, 4) );
+                        *pOut  = ( ${sat("sum", 4, config.out_signed)} );
                         row_per_byte_out--;
                         break;
                     case 1:
-                        *pOut++ |= ( __USAT(sum, 4) << 4 );
+                        *pOut++ |= ( ${sat("sum", 4, config.out_signed)} << 4 );
                         row_per_byte_out=2;
                         break;
                 }
-% elif config.out_data_t=='u2':
+% elif out_t=='u2':
                 switch(row_per_byte_out){
                     case 4:
-                        *pOut  = ( __USAT(sum, 2) );
+                        *pOut  = ( ${sat("sum", 2, config.out_signed)} );
                         row_per_byte_out--;
                         break;
                     case 3:
-                        *pOut |= ( __USAT(sum, 2) << 2);
+                        *pOut |= ( ${sat("sum", 2, config.out_signed)} << 2);
                         row_per_byte_out--;
                         break;
                     case 2:
-                        *pOut |= ( __USAT(sum, 2) << 4);
+                        *pOut |= ( ${sat("sum", 2, config.out_signed)} << 4);
                         row_per_byte_out--;
                         break;
                     case 1:
-                        *pOut++ |= ( __USAT(sum, 2) << 6);
+                        *pOut++ |= ( ${sat("sum", 2, config.out_signed)} << 6);
                         row_per_byte_out-=4;
                         break;
                 }
 % endif
+                row_shift++;
                 rowCnt--;
-% if config.wt_data_t=='u4':
-                row_per_byte--;
-                if(!row_per_byte){
-                    row_per_byte=2;
-                    row_shift_wt++;
-                }
-% elif config.wt_data_t=='u2':
-                row_per_byte--;
-                if(!row_per_byte){
-                    row_per_byte=4;
-                    row_shift_wt++;
-                }
-% endif
             }
             /* clear counter and pointers */
             pBuffer = colBuffer;
         }
+% if config.fused and not config.inverted_residual:
+
+        /* pointwise convolution of the depthwise output row, two pixels at a time */
+${pointwise_row("pRow", config.out_data_t, ch_dw, "z_out", "dim_im_out", "wt_pw", "ch_im_out_pw", "bias_pw",
+                packed("Im_out", "i_out_y * dim_im_out * ch_im_out_pw", config.pw_out_data_t), config.pw_out_data_t,
+                config.nn_mat_mul_fn, config.nn_mat_mul_strided_fn, "_pw")}\
+% elif config.inverted_residual:
+
+        /* projection of the depthwise output row, two pixels at a time: the int32_t sums are
+           requantized and added to the rescaled input before the saturation */
+        {
+            uint8_t *pDst = ${packed("Im_out", "i_out_y * dim_im_out * ch_im_out_pw", config.pw_out_data_t)};
+            int32_t i_pix, i_el, i_res, el_end;
+            cmixnn_dim_t i_ch;
+
+            for (i_pix = 0; i_pix < dim_im_out; i_pix += 2)
+            {
+                /* a leftover pixel fills both columns */
+                arm_${config.out_data_t}_to_int16_reordered(${packed("pRow", "i_pix * " + ch_dw, config.out_data_t)},
+                                            bufferA,
+                                            ${ch_dw},
+                                            z_out);
+                arm_${config.out_data_t}_to_int16_reordered(${packed("pRow", "(i_pix + (i_pix + 1 < dim_im_out)) * " + ch_dw, config.out_data_t)},
+                                            bufferA + ${ch_dw},
+                                            ${ch_dw},
+                                            z_out);
+                for (i_ch = 0; i_ch < ch_im_out_pw; i_ch++)
+                {
+                    pSum[i_ch] = bias_pw[i_ch];
+                    pSum[ch_im_out_pw + i_ch] = bias_pw[i_ch];
+                }
+                ${config.nn_mat_mul_partial_pw_fn}(wt_pw,
+                                                bufferA,
+                                                ch_im_out_pw,
+                                                ${ch_dw},
+                                                ${ch_dw},
+                                                ${ch_dw},
+                                                ${ch_dw},
+                                                pSum,
+                                                z_wt_pw);
+
+                /* i_el is relative to the pixel pair, which starts on a byte boundary of the packed output */
+                el_end = (i_pix + 1 < dim_im_out ? 2 : 1) * ch_im_out_pw;
+                for (i_el = 0; i_el < el_end; i_el++)
+                {
+                    int32_t sum = pSum[i_el];
+
+                    i_ch = i_el % ch_im_out_pw;
+%   if config.folding == "thr":
+                    /* Normalize by Thresholds (${config.pw_out_data_t} output) */
+%     if config.pw_out_data_t == 'u4':
+                    sum = __int16_to_u4((int16_t) sum, &thresholds_pw[i_ch << 4]);
+%     else:
+                    sum = __int16_to_u2((int16_t) sum, &thresholds_pw[i_ch << 2]);
+%     endif
+%   elif config.folding == "icn":
+                    /* Normalize by ICN (${config.pw_out_data_t} output) */
+                    __n_zero_negative_normalization(n_zero_pw[i_ch],&n_zero1,&n_zero2);
+                    sum = ((__HI_SMULL(sum << n_zero1, m_zero_pw[i_ch])) >> n_zero2) + z_out_pw;
+%   else:
+                    /* Normalize by PACT+FW (${config.pw_out_data_t} output) */
+                    sum = ((__HI_SMULL(sum << n_zero_pw1, m_zero_pw)) >> n_zero_pw2) + z_out_pw;
+%   endif
+                    if (m_res != 0)
+                    {
+                        /* residual add, the input has the shape of the output */
+                        i_res = (i_out_y * dim_im_out + i_pix) * ch_im_out_pw + i_el;
+                        sum += (__HI_SMULL((${get_el("Im_in", config.ir_in_data_t).replace("i_el", "i_res")} - z_in) << n_res1, m_res)) >> n_res2;
+                    }
+
+                    /* Store Outputs (${config.pw_out_data_t} output) */
+%   if config.pw_out_data_t == 'u8':
+                    *pDst++ = (uint8_t) __USAT(sum, 8);
+%   elif config.pw_out_data_t == 'u4':
+                    if (i_el & 0x1)
+                    {
+                        *pDst++ |= __USAT(sum, 4) << 4;
+                    }
+                    else
+                    {
+                        *pDst = __USAT(sum, 4);
+                    }
+%   elif config.pw_out_data_t == 'u2':
+                    if (i_el & 0x3)
+                    {
+                        *pDst |= __USAT(sum, 2) << ((i_el & 0x3) << 1);
+                    }
+                    else
+                    {
+                        *pDst = __USAT(sum, 2);
+                    }
+                    pDst += ((i_el & 0x3) == 0x3);
+%   endif
+                }
+            }
+        }
+% endif
     }
 #else
     #error "Cortex-M0 and Cortex-M3 not supported"
@@ -0,0 +1,210 @@
+<%!
+    bits = {'u8': 8, 'u4': 4, 'u2': 2}
+%>\
+<%def name="unpack(data_t, src, dst, z_vect)">\
+<% n_out = 32 // bits[data_t] // 2 %>\
+        ${src} = read_and_pad_reordered_${data_t}((void *) ${src}, ${", ".join("&in" + str(k + 1) for k in range(n_out))});
+%   for k in range(0, n_out, 2):
+        *__SIMD32(${dst})++ = __SSUB16(__PKHBT(in${k + 1}, in${k + 2}, 16), ${z_vect});
+%   endfor
+%   for k in range(0, n_out, 2):
+        *__SIMD32(${dst})++ = __SSUB16(__PKHTB(in${k + 2}, in${k + 1}, 16), ${z_vect});
+%   endfor
+</%def>\
+<%def name="get_el(ptr, data_t)">\
+% if data_t == 'u8':
+${ptr}[i_el]\
+% elif data_t == 'u4':
+((${ptr}[i_el >> 1] >> ((i_el & 0x1) << 2)) & 0x0F)\
+% else:
+((${ptr}[i_el >> 2] >> ((i_el & 0x3) << 1)) & 0x03)\
+% endif
+</%def>\
+<%
+    block = 32 // min(bits[config.in_data_t], bits[config.in2_data_t], bits[config.out_data_t])
+    out_bits = bits[config.out_data_t]
+    max_words = max(32 // bits[config.in_data_t], 32 // bits[config.in2_data_t]) // 2
+%>\
+${config.header_top}
+ * Description:  Mixed Precision element-wise ${"addition" if config.op == "add" else "multiplication"} of ${config.in_data_t} and
+ *               ${config.in2_data_t} tensors producing ${config.out_data_t} output activations.
+${config.header_bottom}
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXBasicMath
+ * @{
+ */
+
+  /**
+   * @brief Mixed Precision element-wise ${"addition" if config.op == "add" else "multiplication"} (a: ${config.in_data_t}, b: ${config.in2_data_t}, out: ${config.out_data_t})
+   *
+   * @param[in]       pA          pointer to the first input tensor
+   * @param[in]       pB          pointer to the second input tensor
+   * @param[in,out]   pOut        pointer to the output tensor
+   * @param[in]       size        number of elements
+   * @param[in]       z_a         first input offset
+% if config.op == "add":
+   * @param[in]       m_a         first input m quantization param
+   * @param[in]       n_a         first input n quantization param
+   * @param[in]       z_b         second input offset
+   * @param[in]       m_b         second input m quantization param
+   * @param[in]       n_b         second input n quantization param
+   * @param[in]       z_out       output offset
+% else:
+   * @param[in]       z_b         second input offset
+   * @param[in]       z_out       output offset
+   * @param[in]       m_zero      m zero quantization param
+   * @param[in]       n_zero      n zero quantization param
+% endif
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   * @details
+   *
+% if config.op == "add":
+   * out = requant(a - z_a) + requant(b - z_b) + z_out, each input rescaled to the output by its own
+   * (m, n) pair as in the ICN normalization.
+% else:
+   * out = requant((a - z_a) * (b - z_b)) + z_out.
+% endif
+   * The tensors are packed: ${block} elements are processed per iteration, reading and writing whole
+   * 32-bit words. The inputs are expanded to int16_t pairs with SIMD instructions; the leftover
+   * elements are processed one by one.
+   */
+arm_status
+${config.fn_name}(const uint8_t *pA,
+                    const uint8_t *pB,
+                    uint8_t *pOut,
+                    const cmixnn_dim_t size,
+                    const uint8_t z_a,
+% if config.op == "add":
+                    const int32_t m_a,
+                    const int8_t n_a,
+                    const uint8_t z_b,
+                    const int32_t m_b,
+                    const int8_t n_b,
+                    const uint8_t z_out)
+% else:
+                    const uint8_t z_b,
+                    const uint8_t z_out,
+                    const int32_t m_zero,
+                    const int8_t n_zero)
+% endif
+{
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    const uint8_t *pInA = pA;
+    const uint8_t *pInB = pB;
+    uint8_t *pDst = pOut;
+    int32_t bufA[${block // 2}];
+    int32_t bufB[${block // 2}];
+    int32_t *pBuf;
+    int32_t ${", ".join("in" + str(k + 1) for k in range(max_words))};
+    int32_t sum;
+    uint32_t out_word;
+    cmixnn_dim_t blkCnt = size / ${block};
+    cmixnn_dim_t i_el;
+    int16_t Vz_a[2] = {z_a, z_a};
+    int16_t Vz_b[2] = {z_b, z_b};
+    const int32_t *pz_a = (int32_t *) Vz_a;
+    const int32_t *pz_b = (int32_t *) Vz_b;
+    const int32_t z_a_vect = *__SIMD32(pz_a);
+    const int32_t z_b_vect = *__SIMD32(pz_b);
+% if config.op == "add":
+    int8_t n_a1, n_a2, n_b1, n_b2;
+
+    __n_zero_negative_normalization(n_a, &n_a1, &n_a2);
+    __n_zero_negative_normalization(n_b, &n_b1, &n_b2);
+% else:
+    int8_t n_zero1, n_zero2;
+
+    __n_zero_negative_normalization(n_zero, &n_zero1, &n_zero2);
+% endif
+
+    while (blkCnt > 0u)
+    {
+        /* expand ${block} elements of each input to int16_t, without the offsets */
+        pBuf = bufA;
+% for w in range(block * bits[config.in_data_t] // 32):
+${unpack(config.in_data_t, "pInA", "pBuf", "z_a_vect")}\
+% endfor
+        pBuf = bufB;
+% for w in range(block * bits[config.in2_data_t] // 32):
+${unpack(config.in2_data_t, "pInB", "pBuf", "z_b_vect")}\
+% endfor
+
+        out_word = 0;
+        for (i_el = 0; i_el < ${block}; i_el += 2)
+        {
+            const int32_t a = bufA[i_el >> 1];
+            const int32_t b = bufB[i_el >> 1];
+
+% for half, el_a, el_b, mask in (("B", "((int16_t) a)", "((int16_t) b)", "0x0000FFFF"), ("T", "(a >> 16)", "(b >> 16)", "0xFFFF0000")):
+%   if config.op == "add":
+            sum = ((__HI_SMULL(${el_a} << n_a1, m_a)) >> n_a2)
+                + ((__HI_SMULL(${el_b} << n_b1, m_b)) >> n_b2) + z_out;
+%   else:
+            sum = ((__HI_SMULL(__SMUAD(a, b & ${mask}) << n_zero1, m_zero)) >> n_zero2) + z_out;
+%   endif
+%   if half == "B":
+            out_word |= __USAT(sum, ${out_bits}) << ((i_el & ${32 // out_bits - 1}) * ${out_bits});
+%   else:
+            out_word |= __USAT(sum, ${out_bits}) << (((i_el + 1) & ${32 // out_bits - 1}) * ${out_bits});
+%   endif
+% endfor
+% if block > 32 // out_bits:
+
+            if (((i_el + 2) & ${32 // out_bits - 1}) == 0)
+            {
+                /* a whole output word is ready */
+                *__SIMD32(pDst)++ = out_word;
+                out_word = 0;
+            }
+% endif
+        }
+% if block == 32 // out_bits:
+        *__SIMD32(pDst)++ = out_word;
+% endif
+
+        /* Decrement the loop counter */
+        blkCnt--;
+    }
+
+    /* leftover elements */
+    for (i_el = size - size % ${block}; i_el < size; i_el++)
+    {
+        const int32_t a = ${get_el("pA", config.in_data_t)} - z_a;
+        const int32_t b = ${get_el("pB", config.in2_data_t)} - z_b;
+
+% if config.op == "add":
+        sum = ((__HI_SMULL(a << n_a1, m_a)) >> n_a2) + ((__HI_SMULL(b << n_b1, m_b)) >> n_b2) + z_out;
+% else:
+        sum = ((__HI_SMULL((a * b) << n_zero1, m_zero)) >> n_zero2) + z_out;
+% endif
+% if config.out_data_t == 'u8':
+        pOut[i_el] = (uint8_t) __USAT(sum, 8);
+% elif config.out_data_t == 'u4':
+        pOut[i_el >> 1] = (pOut[i_el >> 1] & ~(0x0F << ((i_el & 0x1) << 2))) | (__USAT(sum, 4) << ((i_el & 0x1) << 2));
+% elif config.out_data_t == 'u2':
+        pOut[i_el >> 2] = (pOut[i_el >> 2] & ~(0x03 << ((i_el & 0x3) << 1))) | (__USAT(sum, 2) << ((i_el & 0x3) << 1));
+% endif
+    }
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXBasicMath group
+ */
@@ -1,65 +1,166 @@
+<%
+    # packing of the weights, the same for the signed ones
+    wt_t = config.wt_data_t.replace('s', 'u')
+    out_t = config.out_data_t.replace('s', 'u')
+%>\
 ${config.header_top}
  * Description:  Matrix-Multiplication function for
  *               ${config.wt_data_t} x int16_t convolution with reordered columns.
+% if config.out_data_t == 'int32':
+ *               Output is accumulated into int32_t partial sums.
+% else:
  *               Output is then quantized to ${config.out_data_t} using ${config.folding}
  *               config.folding technique.
+% endif
  ${config.header_bottom}
  
 #include "arm_cmixnn.h"
 
   /**
    * @brief Matrix-Multiplication function for ${config.wt_data_t} x int16_t convolution with reordered columns.
+% if config.out_data_t == 'int32':
+   *        Output is accumulated into int32_t partial sums.
+% else:
    *        Output is then quantized to ${config.out_data_t} using ${config.folding} config.folding technique.
+% endif
    * @param[in]       pA          pointer to operand A
    * @param[in]       pInBuffer   pointer to operand B, always consists of 2 vectors
    * @param[in]       ch_im_out   numRow of A
    * @param[in]       numCol_A    numCol of A
+% if config.windowed:
+   * @param[in]       seg_len     columns of A read contiguously, a multiple of 32-bit words of A unless equal to numCol_A
+   * @param[in]       seg_stride  columns of A between the beginning of two consecutive segments
+   * @param[in]       row_len     columns of A between two consecutive rows
+% endif
+% if config.partial:
+   * @param[in,out]   pSum        partial sums of the two output pixels (2*ch_im_out, pixel by pixel), bias included
+% elif config.folding=="icn_rec":
+   * @param[in]       ch_params   pointer to the requantization records of the output channels (bias, m_zero, n_zero, z_wt)
+% else:
    * @param[in]       bias        the bias
+% endif
+% if config.out_data_t != 'int32':
    * @param[in,out]   pOut        pointer to output
+% endif
+% if config.strided and config.out_data_t != 'int32':
+   * @param[in]       ch_out_stride  number of channels between two consecutive output pixels
+% endif
+% if config.quantization=="PACT" and not config.wt_signed:
    * @param[in]       z_a         A operand offset
-% if config.quantization=="PACT":
-   * @param[in]       z_a         A operand offset
-% elif config.quantization=="PACT_CH":
+% elif config.quantization=="PACT_CH" and config.folding!="icn_rec" and not config.wt_signed:
    * @param[in]       *z_a        pointer to A operand offsets (per-output channel)
 % endif
-% if config.folding=="thr":
+% if config.out_data_t == 'int32':
+% elif config.folding=="thr":
    * @param[in]       thresholds  pointer to thresholds for quantization
 % elif config.folding=="icn":
    * @param[in]       z_out       output offset
    * @param[in]       m_zero      pointer to m zero quantization params (per-output-ch)
    * @param[in]       n_zero      pointer to n zero quantization params (per-output-ch)
+% elif config.folding=="icn_rec":
+   * @param[in]       z_out       output offset
+% elif config.folding=="pow2":
+   * @param[in]       z_out       output offset
+   * @param[in]       n_zero      right shift of the power-of-two scale, 0 to 31
 % else:
    * @param[in]       z_out       output offset
    * @param[in]       m_zero      m zero quantization param
    * @param[in]       n_zero      n zero quantization param
 % endif
+% if config.out_data_t == 'int32':
+   * @return none.
+% else:
    * @return     The function returns the incremented output pointer
+% endif
    *
    * @details
    *
-   * This function assumes that data in pInBuffer are reordered
+   * This function assumes that data in pInBuffer are reordered. Each row of A starts on a
+   * byte boundary: the leftover columns of a row (numCol_A not multiple of a 32-bit word of
+   * weights) are stored in natural order after the reordered words and the row is padded
+   * up to the next byte.
+% if config.wt_signed:
+   *
+   * The weights are signed and symmetric: no offset is subtracted from them.
+%   if config.wt_data_t != 's8':
+   * They are decoded scaled by ${16 if config.wt_data_t == 's4' else 64}, the sums over the reordered words are scaled
+   * back before adding the bias.
+%   endif
+% endif
+% if config.out_signed:
+   *
+   * The outputs are signed (two's complement): they are saturated with __SSAT and z_out is signed.
+% endif
+% if config.windowed:
+   *
+   * Only a window of each row of A is used: numCol_A columns read in segments of seg_len
+   * columns, seg_stride columns apart, starting at pA. Rows of A are row_len columns apart.
+% endif
+% if config.partial and config.out_data_t == 'int32':
+   *
+   * The products are accumulated into pSum, no output is quantized. Used for the first chunks
+   * of the input channels of a split-K convolution.
+% elif config.partial:
+   *
+   * The products are accumulated on top of pSum and then quantized. Used for the last chunk
+   * of the input channels of a split-K convolution.
+% endif
    */
 
+% if config.out_data_t == 'int32':
+void
+${config.fn_name}(const uint8_t * pA,
+% else:
 uint8_t
 *${config.fn_name}(const uint8_t * pA,
+% endif
                             const int16_t * pInBuffer,
-                            const uint16_t ch_im_out,
-                            const uint16_t numCol_A,
+                            const cmixnn_dim_t ch_im_out,
+                            const cmixnn_dim_t numCol_A,
+% if config.windowed:
+                            const cmixnn_dim_t seg_len,
+                            const cmixnn_dim_t seg_stride,
+                            const cmixnn_dim_t row_len,
+% endif
+% if config.partial:
+                            int32_t * pSum,
+% elif config.folding=="icn_rec":
+                            const cmixnn_icn_rec_t * ch_params,
+% else:
                             const int32_t * bias,
+% endif
+% if config.out_data_t == 'int32':
+%   if config.quantization=="PACT":
+                            const uint8_t z_a)
+%   elif config.quantization=="PACT_CH":
+                            const uint8_t *z_a)
+%   endif
+% else:
                             uint8_t * pOut,
-% if config.quantization=="PACT":
+% endif
+% if config.strided and config.out_data_t != 'int32':
+                            const cmixnn_dim_t ch_out_stride,
+% endif
+% if config.out_data_t == 'int32':
+% elif config.quantization=="PACT" and not config.wt_signed:
                             const uint8_t z_a,
-% elif config.quantization=="PACT_CH":
+% elif config.quantization=="PACT_CH" and config.folding!="icn_rec" and not config.wt_signed:
                             const uint8_t *z_a,
 % endif
-% if config.folding=="thr":
+% if config.out_data_t == 'int32':
+% elif config.folding=="thr":
                             const int16_t * thresholds)
 % elif config.folding=="icn":
-                            const uint8_t z_out,
+                            const ${config.z_out_t} z_out,
                             const int32_t *m_zero,
                             const int8_t *n_zero)
+% elif config.folding=="icn_rec":
+                            const ${config.z_out_t} z_out)
+% elif config.folding=="pow2":
+                            const ${config.z_out_t} z_out,
+                            const int8_t n_zero)
 % else:
-                            const uint8_t z_out,
+                            const ${config.z_out_t} z_out,
                             const int32_t m_zero,
                             const int8_t n_zero)
 % endif
@@ -67,14 +168,25 @@ uint8_t
 
 #if defined (ARM_MATH_DSP)
     /* set up the second output pointers */
-% if config.out_data_t=='u8':
+% if config.strided:
+%   if out_t=='u8':
+    uint8_t *pOut2 = pOut + ch_out_stride;
+%   elif out_t=='u4':
+    uint8_t *pOut2 = pOut + (ch_out_stride>>1); // config.out_data_t: u4 (2CHs per-Bytes)
+%   elif out_t=='u2':
+    uint8_t *pOut2 = pOut + (ch_out_stride>>2); // config.out_data_t: u2 (4CHs per-Bytes)
+%   endif
+% else:
+%   if out_t=='u8':
     uint8_t *pOut2 = pOut + ch_im_out;
-% elif config.out_data_t=='u4':
+%   elif out_t=='u4':
     uint8_t *pOut2 = pOut + (ch_im_out>>1); // config.out_data_t: u4 (2CHs per-Bytes)
-% elif config.out_data_t=='u2':
+%   elif out_t=='u2':
     uint8_t *pOut2 = pOut + (ch_im_out>>2); // config.out_data_t: u2 (2CHs per-Bytes)
+%   endif
 % endif
     int     i;
+    cmixnn_dim_t j;
     const int16_t *pB = pInBuffer;
     const int16_t *pB2 = pB + numCol_A;
 
@@ -87,9 +199,12 @@ uint8_t
     /* Negative N_ZERO Normalization */
     int8_t n_zero1;
     int8_t n_zero2;
+% elif config.folding == "pow2":
+    /* Rounding of the power-of-two scale */
+    const int32_t n_round = (int32_t) ((1u << n_zero) >> 1);
 % endif
 
-% if config.quantization=="PACT":
+% if config.quantization=="PACT" and not config.wt_signed:
     int16_t VzA[2] = {z_a,z_a};
     const int16_t *pzA = VzA;
     int32_t inzA = *__SIMD32(pzA);
@@ -98,7 +213,7 @@ uint8_t
     int32_t z_a_offset  = 0;
     int32_t z_a_offset2 = 0;
 
-    for (i = 0; i < numCol_A; i += 2) {
+    for (i = 0; i < numCol_A - 1; i += 2) {
         int32_t inB1 = *__SIMD32(pB)++;
         int32_t inB2 = *__SIMD32(pB2)++;
         z_a_offset = __SMLAD(inzA, inB1, z_a_offset);
@@ -123,19 +238,54 @@ uint8_t
         pB2 = pB + numCol_A;
 
         /* align the second pointer for A */
-% if config.wt_data_t=='u8':
+% if config.windowed:
+        const uint8_t *pA_row = pA;
+%   if wt_t=='u8':
+        const uint8_t *pA2 = pA + row_len;
+%   elif wt_t=='u4':
+        const uint8_t *pA2 = pA + ((row_len + 1)>>1); // config.wt_data_t: u4 (2Cols per-Byte)
+%   elif wt_t=='u2':
+        const uint8_t *pA2 = pA + ((row_len + 3)>>2); // config.wt_data_t: u2 (4Cols per-Byte)
+%   endif
+% elif wt_t=='u8':
         const uint8_t *pA2 = pA + numCol_A;
-% elif config.wt_data_t=='u4':
-        const uint8_t *pA2 = pA + (numCol_A>>1); // config.wt_data_t: u4 (4Cols per-Byte)
-% elif config.wt_data_t=='u2':
-        const uint8_t *pA2 = pA + (numCol_A>>2); // config.wt_data_t: u2 (8Cols per-Byte)
+% elif wt_t=='u4':
+        const uint8_t *pA2 = pA + ((numCol_A + 1)>>1); // config.wt_data_t: u4 (2Cols per-Byte)
+% elif wt_t=='u2':
+        const uint8_t *pA2 = pA + ((numCol_A + 3)>>2); // config.wt_data_t: u2 (4Cols per-Byte)
 % endif
 
-% if config.quantization=="PACT":
+% if config.wt_signed and config.wt_data_t != 's8':
+        /* the bias is added once the sums are scaled back */
+        int32_t     sum =  0;
+        int32_t     sum2 = 0;
+        int32_t     sum3 = 0;
+        int32_t     sum4 = 0;
+% elif config.wt_signed:
+        int32_t     sum =  bias[i];
+        int32_t     sum2 = bias[i];
+        int32_t     sum3 = bias[i + 1];
+        int32_t     sum4 = bias[i + 1];
+% elif config.quantization=="PACT" and config.partial:
+        int32_t     sum =  pSum[i] - z_a_offset;
+        int32_t     sum2 = pSum[ch_im_out + i] - z_a_offset2;
+        int32_t     sum3 = pSum[i + 1] - z_a_offset;
+        int32_t     sum4 = pSum[ch_im_out + i + 1] - z_a_offset2;
+% elif config.quantization=="PACT":
         int32_t     sum =  bias[i] - z_a_offset;
         int32_t     sum2 = bias[i] - z_a_offset2;
         int32_t     sum3 = bias[i + 1] - z_a_offset;
         int32_t     sum4 = bias[i + 1] - z_a_offset2;
+% elif config.folding=="icn_rec":
+        /* requantization records of the two rows */
+        const cmixnn_icn_rec_t *pRec = ch_params + i;
+        int32_t inzA = pRec[0].z_wt;
+        int32_t inzA2 = pRec[1].z_wt;
+
+        int32_t     sum =  pRec[0].bias;
+        int32_t     sum2 = pRec[0].bias;
+        int32_t     sum3 = pRec[1].bias;
+        int32_t     sum4 = pRec[1].bias;
 % else:
         int16_t VzA[2] = {z_a[i],z_a[i]};
         const int16_t *pzA = VzA;
@@ -145,27 +295,43 @@ uint8_t
         const int16_t *pzA2 = VzA2;
         int32_t inzA2 = *__SIMD32(pzA2);
 
+%   if config.partial:
+        int32_t     sum =  pSum[i];
+        int32_t     sum2 = pSum[ch_im_out + i];
+        int32_t     sum3 = pSum[i + 1];
+        int32_t     sum4 = pSum[ch_im_out + i + 1];
+%   else:
         int32_t     sum =  bias[i];
         int32_t     sum2 = bias[i];
         int32_t     sum3 = bias[i + 1];
         int32_t     sum4 = bias[i + 1];
+%   endif
 % endif
 
-% if config.wt_data_t=='u8':
-        uint16_t  colCnt = numCol_A >> 2;
-% elif config.wt_data_t=='u4':
-        uint16_t  colCnt = numCol_A >> 3; // config.wt_data_t: u4 (8x uint4_t)
-% elif config.wt_data_t=='u2':
-        uint16_t  colCnt = numCol_A >> 4; // config.wt_data_t: u2 (16x uint2_t)
+% if wt_t=='u8':
+        cmixnn_dim_t  colCnt = numCol_A >> 2;
+% elif wt_t=='u4':
+        cmixnn_dim_t  colCnt = numCol_A >> 3; // config.wt_data_t: u4 (8x uint4_t)
+% elif wt_t=='u2':
+        cmixnn_dim_t  colCnt = numCol_A >> 4; // config.wt_data_t: u2 (16x uint2_t)
+% endif
+% if config.windowed:
+%   if wt_t=='u8':
+        cmixnn_dim_t  segCnt = seg_len >> 2;
+%   elif wt_t=='u4':
+        cmixnn_dim_t  segCnt = seg_len >> 3;
+%   elif wt_t=='u2':
+        cmixnn_dim_t  segCnt = seg_len >> 4;
+%   endif
 % endif
 
         /* accumulate over the vector */
         while (colCnt)
         {
             int32_t inA11, inA12, inA21, inA22;
-% if config.wt_data_t=='u4':
+% if wt_t=='u4':
             int32_t inA13, inA14, inA23, inA24;
-% elif config.wt_data_t=='u2':
+% elif wt_t=='u2':
             int32_t inA13, inA14, inA23, inA24;
             int32_t inA15, inA16, inA25, inA26;
             int32_t inA17, inA18, inA27, inA28;
@@ -174,19 +340,19 @@ uint8_t
             int32_t inB1 = *__SIMD32(pB)++;
             int32_t inB2 = *__SIMD32(pB2)++;
 
-% if config.wt_data_t=='u8':
-            pA = (uint8_t *) read_and_pad_reordered_u8((void *)pA, &inA11, &inA12);
-            pA2 = (uint8_t *) read_and_pad_reordered_u8((void *)pA2, &inA21, &inA22);
-%   if config.quantization=="PACT_CH":
+% if wt_t=='u8':
+            pA = (uint8_t *) read_and_pad_reordered_${config.wt_data_t}((void *)pA, &inA11, &inA12);
+            pA2 = (uint8_t *) read_and_pad_reordered_${config.wt_data_t}((void *)pA2, &inA21, &inA22);
+%   if config.quantization=="PACT_CH" and not config.wt_signed:
             inA11 = __SSUB16(inA11, inzA);
             inA12 = __SSUB16(inA12, inzA);
             inA21 = __SSUB16(inA21, inzA2);
             inA22 = __SSUB16(inA22, inzA2);
 %   endif
-% elif config.wt_data_t=='u4':
-            pA = (uint8_t *) read_and_pad_reordered_u4((void *)pA, &inA11, &inA12, &inA13, &inA14);
-            pA2 = (uint8_t *) read_and_pad_reordered_u4((void *)pA2, &inA21, &inA22, &inA23, &inA24);
-%   if config.quantization=="PACT_CH":
+% elif wt_t=='u4':
+            pA = (uint8_t *) read_and_pad_reordered_${config.wt_data_t}((void *)pA, &inA11, &inA12, &inA13, &inA14);
+            pA2 = (uint8_t *) read_and_pad_reordered_${config.wt_data_t}((void *)pA2, &inA21, &inA22, &inA23, &inA24);
+%   if config.quantization=="PACT_CH" and not config.wt_signed:
             inA11 = __SSUB16(inA11, inzA);
             inA12 = __SSUB16(inA12, inzA);
             inA21 = __SSUB16(inA21, inzA2);
@@ -196,10 +362,10 @@ uint8_t
             inA23 = __SSUB16(inA23, inzA2);
             inA24 = __SSUB16(inA24, inzA2);
 %   endif
-% elif config.wt_data_t=='u2':
-            pA = (uint8_t *) read_and_pad_reordered_u2((void *)pA, &inA11, &inA12, &inA13, &inA14, &inA15, &inA16, &inA17, &inA18);
-            pA2 = (uint8_t *) read_and_pad_reordered_u2((void *)pA2, &inA21, &inA22, &inA23, &inA24, &inA25, &inA26, &inA27, &inA28);
-%   if config.quantization=="PACT_CH":
+% elif wt_t=='u2':
+            pA = (uint8_t *) read_and_pad_reordered_${config.wt_data_t}((void *)pA, &inA11, &inA12, &inA13, &inA14, &inA15, &inA16, &inA17, &inA18);
+            pA2 = (uint8_t *) read_and_pad_reordered_${config.wt_data_t}((void *)pA2, &inA21, &inA22, &inA23, &inA24, &inA25, &inA26, &inA27, &inA28);
+%   if config.quantization=="PACT_CH" and not config.wt_signed:
             inA11 = __SSUB16(inA11, inzA);
             inA12 = __SSUB16(inA12, inzA);
             inA21 = __SSUB16(inA21, inzA2);
@@ -232,7 +398,7 @@ uint8_t
             sum3 = __SMLAD(inA22, inB1, sum3);
             sum4 = __SMLAD(inA22, inB2, sum4);
 
-% if config.wt_data_t=='u4':
+% if wt_t=='u4':
             inB1 = *__SIMD32(pB)++;
             inB2 = *__SIMD32(pB2)++;
 
@@ -249,7 +415,7 @@ uint8_t
             sum3 = __SMLAD(inA24, inB1, sum3);
             sum4 = __SMLAD(inA24, inB2, sum4);
 
-% elif config.wt_data_t=='u2':
+% elif wt_t=='u2':
             inB1 = *__SIMD32(pB)++;
             inB2 = *__SIMD32(pB2)++;
 
@@ -299,66 +465,87 @@ uint8_t
             sum4 = __SMLAD(inA28, inB2, sum4);
 % endif
             colCnt--;
+% if config.windowed:
+
+            if (--segCnt == 0)
+            {
+                /* jump to the next segment of the window */
+%   if wt_t=='u8':
+                pA += seg_stride - seg_len;
+                pA2 += seg_stride - seg_len;
+                segCnt = seg_len >> 2;
+%   elif wt_t=='u4':
+                pA += (seg_stride - seg_len) >> 1;
+                pA2 += (seg_stride - seg_len) >> 1;
+                segCnt = seg_len >> 3;
+%   elif wt_t=='u2':
+                pA += (seg_stride - seg_len) >> 2;
+                pA2 += (seg_stride - seg_len) >> 2;
+                segCnt = seg_len >> 4;
+%   endif
+            }
+% endif
         } /* while over colCnt */
+% if config.wt_signed and config.wt_data_t != 's8':
 
-#if 0
-% if config.wt_data_t=='u8':
-        colCnt = numCol_A & 0x3; // config.wt_data_t: u4 (4x uint8_t)
-% elif config.wt_data_t=='u4':
-        colCnt = numCol_A & 0x7;; // config.wt_data_t: u4 (8x uint4_t)
-% elif config.wt_data_t=='u2':
-        colCnt = numCol_A & 0xf; // config.wt_data_t: u2 (16x uint2_t)
+        /* scale back the sums, exact as every product is a multiple of ${16 if config.wt_data_t == 's4' else 64} */
+        sum  = bias[i] + (sum >> ${4 if config.wt_data_t == 's4' else 6});
+        sum2 = bias[i] + (sum2 >> ${4 if config.wt_data_t == 's4' else 6});
+        sum3 = bias[i + 1] + (sum3 >> ${4 if config.wt_data_t == 's4' else 6});
+        sum4 = bias[i + 1] + (sum4 >> ${4 if config.wt_data_t == 's4' else 6});
 % endif
 
-% if config.wt_data_t=='u4':
-        int wt_per_byte = 2;
-% elif config.wt_data_t=='u2':
-        int wt_per_byte = 4;
+% if wt_t=='u8':
+        colCnt = numCol_A & 0x3; // config.wt_data_t: u8 (4x uint8_t)
+% elif wt_t=='u4':
+        colCnt = numCol_A & 0x7; // config.wt_data_t: u4 (8x uint4_t)
+% elif wt_t=='u2':
+        colCnt = numCol_A & 0xf; // config.wt_data_t: u2 (16x uint2_t)
 % endif
-        while (colCnt)
+
+        /* leftover columns, not reordered */
+        for (j = 0; j < colCnt; j++)
         {
-            uint8_t inB1 = (uint8_t) *pB++;
-            uint8_t inA1;
+            int16_t inB1 = *pB++;
+            int16_t inB2 = *pB2++;
 % if config.wt_data_t=='u8':
-            inA1 = (uint8_t)*pA++;
+            int16_t inA1 = pA[j];
+            int16_t inA2 = pA2[j];
 % elif config.wt_data_t=='u4':
-            switch(wt_per_byte)
-            {
-                case 2:
-                    inA1 = (uint8_t) __USAT(*pA, 4);
-                    break;
-                 case 1:
-                    inA1 = (uint8_t) __USAT(__ROR(*pA, 4), 4);
-                    pA++;
-                    break;
-            }
+            int16_t inA1 = (pA[j>>1] >> ((j & 0x1)<<2)) & 0x0F;
+            int16_t inA2 = (pA2[j>>1] >> ((j & 0x1)<<2)) & 0x0F;
 % elif config.wt_data_t=='u2':
-            switch(wt_per_byte)
-            {
-                case 4:
-                    inA1 = (uint8_t) __USAT(*pA, 2);
-                    break;
-                case 3:
-                    inA1 = (uint8_t) __USAT(__ROR(*pA, 2), 2);
-                    break;
-                case 2:
-                    inA1 = (uint8_t) __USAT(__ROR(*pA, 2), 4);
-                    break;
-                case 1:
-                    inA1 = (uint8_t) __USAT(__ROR(*pA, 2), 6);
-                    pA++;
-                break;
-            }
+            int16_t inA1 = (pA[j>>2] >> ((j & 0x3)<<1)) & 0x03;
+            int16_t inA2 = (pA2[j>>2] >> ((j & 0x3)<<1)) & 0x03;
+% elif config.wt_data_t=='s8':
+            int16_t inA1 = (int8_t) pA[j];
+            int16_t inA2 = (int8_t) pA2[j];
+% elif config.wt_data_t=='s4':
+            int16_t inA1 = ((int8_t) (pA[j>>1] << ((~j & 0x1)<<2))) >> 4;
+            int16_t inA2 = ((int8_t) (pA2[j>>1] << ((~j & 0x1)<<2))) >> 4;
+% elif config.wt_data_t=='s2':
+            int16_t inA1 = ((int8_t) (pA[j>>2] << ((~j & 0x3)<<1))) >> 6;
+            int16_t inA2 = ((int8_t) (pA2[j>>2] << ((~j & 0x3)<<1))) >> 6;
 % endif
-% if config.quantization=="PACT":
-            inA1 -= z_a;
-% elif config.quantization=="PACT_CH":
+% if config.folding=="icn_rec":
+            inA1 -= (int16_t) inzA;
+            inA2 -= (int16_t) inzA2;
+% elif config.quantization=="PACT_CH" and not config.wt_signed:
             inA1 -= z_a[i];
+            inA2 -= z_a[i + 1];
 % endif
             sum += inA1 * inB1;
-            colCnt--;
+            sum2 += inA1 * inB2;
+            sum3 += inA2 * inB1;
+            sum4 += inA2 * inB2;
         }
-#endif
+% if wt_t=='u8':
+        pA += colCnt;
+% elif wt_t=='u4':
+        pA += (colCnt + 1)>>1;
+% elif wt_t=='u2':
+        pA += (colCnt + 3)>>2;
+% endif
 
 % if config.folding=="thr":
         /* Normalize by Thresholds (${config.out_data_t} output) */
@@ -370,10 +557,10 @@ uint8_t
         sum3 = __int16_to_u4((int16_t) sum3, &thresholds[(i+1)<<4]);
         sum4 = __int16_to_u4((int16_t) sum4, &thresholds[(i+1)<<4]);
 %   elif config.out_data_t=='u2':
-        sum = __int16_to_u2((int16_t) sum , &thresholds[(i++)<<2]);
-        sum2 = __int16_to_u2((int16_t) sum2, &thresholds[(i++)<<2]);
-        sum3 = __int16_to_u2((int16_t) sum3 , &thresholds[(i+1)<<2]);
-        sum4 = __int16_to_u2((int16_t) sum4 , &thresholds[(i+1)<<2]);
+        sum = __int16_to_u2((int16_t) sum, &thresholds[i<<2]);
+        sum2 = __int16_to_u2((int16_t) sum2, &thresholds[i<<2]);
+        sum3 = __int16_to_u2((int16_t) sum3, &thresholds[(i+1)<<2]);
+        sum4 = __int16_to_u2((int16_t) sum4, &thresholds[(i+1)<<2]);
 %   endif
 % elif config.folding=="icn":
         /* Normalize by ICN (${config.out_data_t} output) */
@@ -385,16 +572,33 @@ uint8_t
         sum3  = ((__HI_SMULL(sum3 << n_zero1 ,m_zero[i+1])) >> n_zero2) + z_out;
         __n_zero_negative_normalization(n_zero[i+1],&n_zero1,&n_zero2);
         sum4  = ((__HI_SMULL(sum4 << n_zero1 ,m_zero[i+1])) >> n_zero2) + z_out;
+% elif config.folding=="icn_rec":
+        /* Normalize by the ICN records (${config.out_data_t} output) */
+        sum  = ((__HI_SMULL(sum << pRec[0].n_zero1, pRec[0].m_zero)) >> pRec[0].n_zero2) + z_out;
+        sum2 = ((__HI_SMULL(sum2 << pRec[0].n_zero1, pRec[0].m_zero)) >> pRec[0].n_zero2) + z_out;
+        sum3 = ((__HI_SMULL(sum3 << pRec[1].n_zero1, pRec[1].m_zero)) >> pRec[1].n_zero2) + z_out;
+        sum4 = ((__HI_SMULL(sum4 << pRec[1].n_zero1, pRec[1].m_zero)) >> pRec[1].n_zero2) + z_out;
 % elif config.folding=="weights":
         /* Normalize by PACT+FW (${config.out_data_t} output) */
         sum  = ((__HI_SMULL(sum << n_zero1,m_zero)) >> n_zero2) + z_out;
         sum2 = ((__HI_SMULL(sum2 << n_zero1,m_zero)) >> n_zero2) + z_out;
         sum3 = ((__HI_SMULL(sum3 << n_zero1,m_zero)) >> n_zero2) + z_out;
         sum4 = ((__HI_SMULL(sum4 << n_zero1,m_zero)) >> n_zero2) + z_out;
+% elif config.folding=="pow2":
+        /* Normalize by a rounding shift (${config.out_data_t} output) */
+        sum  = ((sum + n_round) >> n_zero) + z_out;
+        sum2 = ((sum2 + n_round) >> n_zero) + z_out;
+        sum3 = ((sum3 + n_round) >> n_zero) + z_out;
+        sum4 = ((sum4 + n_round) >> n_zero) + z_out;
 % endif
 
         /* Store Outputs (${config.out_data_t} output) */
-% if config.out_data_t=='u8':
+% if config.out_data_t=='int32':
+        pSum[i] = sum;
+        pSum[i + 1] = sum3;
+        pSum[ch_im_out + i] = sum2;
+        pSum[ch_im_out + i + 1] = sum4;
+% elif config.out_data_t=='u8':
         *pOut++ = (uint8_t) __USAT(sum, 8);
         *pOut++ = (uint8_t) __USAT(sum3, 8);
         *pOut2++ = (uint8_t) __USAT(sum2, 8);
@@ -417,30 +621,75 @@ uint8_t
             *pOut2 = ( ( __USAT(sum2, 2)        & 0x03 )
                        | ( __USAT(sum4, 2) << 2 ) & 0x0C );
         }
+% elif config.out_data_t=='s8':
+        *pOut++ = (uint8_t) __SSAT(sum, 8);
+        *pOut++ = (uint8_t) __SSAT(sum3, 8);
+        *pOut2++ = (uint8_t) __SSAT(sum2, 8);
+        *pOut2++ = (uint8_t) __SSAT(sum4, 8);
+% elif config.out_data_t=='s4':
+        *pOut++  = ( (__SSAT(sum,4) & 0x0F) | ((__SSAT(sum3,4) << 4 ) & 0xF0 ));
+        *pOut2++ = ( (__SSAT(sum2,4) & 0x0F) | ((__SSAT(sum4,4) << 4 ) & 0xF0 ));
+% elif config.out_data_t=='s2':
+        if(i & 0x0002 ){ //MSB or-ed with LSB, then increment the pointer
+            *pOut = (  ( __SSAT(sum, 2)  << 4 ) & 0x30
+                     | ( __SSAT(sum3, 2) << 6 ) & 0xC0 )
+                     | *pOut; pOut++;
+            *pOut2 = ( ( __SSAT(sum2, 2) << 4 ) & 0x30
+                     | ( __SSAT(sum4, 2) << 6 ) & 0xC0 )
+                     | *pOut2; pOut2++;
+        }
+        else { // writing LSB first and implicit cleaning of previous junk value
+            *pOut  = ( ( __SSAT(sum, 2)         & 0x03 )
+                       | ( __SSAT(sum3, 2) << 2 ) & 0x0C );
+            *pOut2 = ( ( __SSAT(sum2, 2)        & 0x03 )
+                       | ( __SSAT(sum4, 2) << 2 ) & 0x0C );
+        }
 % endif
 
         /* skip the row computed with A2 */
-% if config.wt_data_t=='u8':
+% if config.windowed:
+%   if wt_t=='u8':
+        pA = pA_row + (row_len << 1);
+%   elif wt_t=='u4':
+        pA = pA_row + (((row_len + 1)>>1) << 1); // config.wt_data_t: u4 (2cols per-Bytes)
+%   elif wt_t=='u2':
+        pA = pA_row + (((row_len + 3)>>2) << 1); // config.wt_data_t: u2 (4cols per-Bytes)
+%   endif
+% elif wt_t=='u8':
         pA += numCol_A;
-% elif config.wt_data_t=='u4':
-        pA += numCol_A>>1; // config.wt_data_t: u4 (2cols per-Bytes)
-% elif config.wt_data_t=='u2':
-        pA += numCol_A>>2; // config.wt_data_t: u2 (4cols per-Bytes)
+% elif wt_t=='u4':
+        pA += (numCol_A + 1)>>1; // config.wt_data_t: u4 (2cols per-Bytes)
+% elif wt_t=='u2':
+        pA += (numCol_A + 3)>>2; // config.wt_data_t: u2 (4cols per-Bytes)
 % endif
     } /* for over ch_im_out */
     
-% if config.out_data_t=='u8':
+% if config.out_data_t=='int32':
+% elif config.strided:
+    /* move to the same channel slice of the next output pixel pair */
+%   if out_t=='u8':
+    pOut += (ch_out_stride<<1) - ch_im_out;
+%   elif out_t=='u4':
+    pOut += ((ch_out_stride<<1) - ch_im_out)>>1; // config.out_data_t: u4 (2CH per-Bytes)
+%   elif out_t=='u2':
+    pOut += ((ch_out_stride<<1) - ch_im_out)>>2; // config.out_data_t: u2 (4CHs per-Bytes)
+%   endif
+% else:
+%   if out_t=='u8':
     pOut += ch_im_out;
-% elif config.out_data_t=='u4':
+%   elif out_t=='u4':
     pOut += ch_im_out>>1; // config.out_data_t: u4 (2CH per-Bytes)
-% elif config.out_data_t=='u2':
+%   elif out_t=='u2':
     pOut += ch_im_out>>2; // config.out_data_t: u2 (4CHs per-Bytes)
+%   endif
 % endif
 #else
     #error "Cortex-M0 and Cortex-M3 not supported"
     /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
 #endif /* ARM_MATH_DSP */
 
+% if config.out_data_t != 'int32':
     /* return the new output pointer with offset */
     return pOut;
+% endif
 }
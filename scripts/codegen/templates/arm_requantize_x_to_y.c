@@ -0,0 +1,166 @@
+<%!
+    bits = {'u8': 8, 'u4': 4, 'u2': 2}
+%>\
+<%
+    block = 32 // min(bits[config.in_data_t], bits[config.out_data_t])
+    out_bits = bits[config.out_data_t]
+    n_out = 32 // bits[config.in_data_t] // 2
+%>\
+${config.header_top}
+ * Description:  Requantizes the elements of a ${config.in_data_t} tensor to a ${config.out_data_t} tensor
+ *               using ${config.folding} folding technique.
+${config.header_bottom}
+
+#include "arm_cmixnn.h"
+
+/**
+ * @ingroup groupSupport
+ */
+
+/**
+ * @addtogroup CMixNN_convert
+ * @{
+ */
+
+/**
+ * @brief Requantizes the elements of a ${config.in_data_t} tensor to a ${config.out_data_t} tensor (${config.folding}).
+ * @param[in] *pSrc       points to the ${config.in_data_t} input tensor
+ * @param[out] *pDst      points to the ${config.out_data_t} output tensor
+ * @param[in] size        number of elements
+ * @param[in] z_in        input quantization offset
+% if config.folding == "thr":
+ * @param[in] thresholds  pointer to the thresholds applied to the input minus z_in (${2 ** out_bits - 1} used, stride ${16 if out_bits == 4 else 4})
+% else:
+ * @param[in] z_out       output quantization offset
+ * @param[in] m_zero      m zero quantization param
+ * @param[in] n_zero      n zero quantization param
+% endif
+ * @return none.
+ *
+ * @details
+ *
+ * ${block} elements are processed per iteration, reading and writing whole 32-bit words of the
+ * packed tensors; the leftover elements are processed one by one.
+ */
+
+void
+${config.fn_name}(
+                        const uint8_t *pSrc,
+                        uint8_t *pDst,
+                        uint32_t size,
+                        const uint8_t z_in,
+% if config.folding == "thr":
+                        const int16_t *thresholds)
+% else:
+                        const uint8_t z_out,
+                        const int32_t m_zero,
+                        const int8_t n_zero)
+% endif
+{
+    const uint8_t *pIn = pSrc;  /* Src pointer */
+    uint8_t *pOut = pDst;       /* Dst pointer */
+    uint32_t  blkCnt;           /* loop counter */
+    uint32_t  i_el;
+    int16_t offsets[2] = {z_in, z_in};
+    const int16_t *offset_ptr = offsets;
+    int32_t   sum;
+
+#ifndef ARM_MATH_CM0_FAMILY
+    int32_t   buf[${block // 2}];
+    int32_t  *pBuf;
+    int32_t   ${", ".join("in" + str(k + 1) for k in range(n_out))};
+    int32_t   offset_vect = *__SIMD32(offset_ptr);
+    uint32_t  out_word;
+% if config.folding != "thr":
+    int8_t    n_zero1, n_zero2;
+
+    __n_zero_negative_normalization(n_zero, &n_zero1, &n_zero2);
+% endif
+
+    blkCnt = size / ${block}u;
+
+    while (blkCnt > 0u)
+    {
+        /* expand ${block} elements to int16_t in natural order, without the offset */
+        pBuf = buf;
+% for w in range(block * bits[config.in_data_t] // 32):
+        pIn = read_and_pad_reordered_${config.in_data_t}((void *) pIn, ${", ".join("&in" + str(k + 1) for k in range(n_out))});
+%   for k in range(0, n_out, 2):
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHBT(in${k + 1}, in${k + 2}, 16), offset_vect);
+%   endfor
+%   for k in range(0, n_out, 2):
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHTB(in${k + 2}, in${k + 1}, 16), offset_vect);
+%   endfor
+% endfor
+
+        out_word = 0;
+        for (i_el = 0; i_el < ${block}u; i_el += 2)
+        {
+            const int32_t in = buf[i_el >> 1];
+
+% for el, inc in (("((int16_t) in)", ""), ("(in >> 16)", " + 1")):
+% if config.folding == "thr":
+%   if out_bits == 4:
+            sum = __int16_to_u4((int16_t) ${el}, thresholds);
+%   else:
+            sum = __int16_to_u2((int16_t) ${el}, thresholds);
+%   endif
+% else:
+            sum = ((__HI_SMULL(${el} << n_zero1, m_zero)) >> n_zero2) + z_out;
+% endif
+            out_word |= __USAT(sum, ${out_bits}) << (((i_el${inc}) & ${32 // out_bits - 1}) * ${out_bits});
+% endfor
+% if block > 32 // out_bits:
+
+            if (((i_el + 2) & ${32 // out_bits - 1}) == 0)
+            {
+                /* a whole output word is ready */
+                *__SIMD32(pOut)++ = out_word;
+                out_word = 0;
+            }
+% endif
+        }
+% if block == 32 // out_bits:
+        *__SIMD32(pOut)++ = out_word;
+% endif
+
+        /* Decrement the loop counter */
+        blkCnt--;
+    }
+#else
+#error "Cortex-M0 is not supported"
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+    /* leftover elements */
+    for (i_el = size - size % ${block}u; i_el < size; i_el++)
+    {
+% if config.in_data_t == 'u8':
+        const int32_t in = pSrc[i_el] - z_in;
+% elif config.in_data_t == 'u4':
+        const int32_t in = ((pSrc[i_el >> 1] >> ((i_el & 0x1) << 2)) & 0x0F) - z_in;
+% elif config.in_data_t == 'u2':
+        const int32_t in = ((pSrc[i_el >> 2] >> ((i_el & 0x3) << 1)) & 0x03) - z_in;
+% endif
+
+% if config.folding == "thr":
+%   if out_bits == 4:
+        sum = __int16_to_u4((int16_t) in, thresholds);
+%   else:
+        sum = __int16_to_u2((int16_t) in, thresholds);
+%   endif
+% else:
+        sum = ((__HI_SMULL(in << n_zero1, m_zero)) >> n_zero2) + z_out;
+% endif
+% if config.out_data_t == 'u8':
+        pDst[i_el] = (uint8_t) __USAT(sum, 8);
+% elif config.out_data_t == 'u4':
+        pDst[i_el >> 1] = (pDst[i_el >> 1] & ~(0x0F << ((i_el & 0x1) << 2))) | (__USAT(sum, 4) << ((i_el & 0x1) << 2));
+% elif config.out_data_t == 'u2':
+        pDst[i_el >> 2] = (pDst[i_el >> 2] & ~(0x03 << ((i_el & 0x3) << 1))) | (__USAT(sum, 2) << ((i_el & 0x3) << 1));
+% endif
+    }
+}
+
+/**
+ * @}
+ */
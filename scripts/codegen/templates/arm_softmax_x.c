@@ -0,0 +1,285 @@
+<%!
+    import math
+    # exp(-k), k integer part of the exponent, in Q15: exp(-11) is below 1 LSB
+    exp_int = [int(round(32768 * math.exp(-k))) for k in range(11)]
+    # exp(-j/16) and exp(-l/256), fractional parts of the exponent, in Q15
+    exp_hi = [int(round(32768 * math.exp(-j / 16.0))) for j in range(16)]
+    exp_lo = [int(round(32768 * math.exp(-l / 256.0))) for l in range(16)]
+%>\
+<%
+    in_ptr_t = "int32_t" if config.in_data_t == "int32" else "uint8_t"
+%>\
+${config.header_top}
+ * Description:  Integer softmax of ${config.in_data_t} logits producing u8 probabilities.
+${config.header_bottom}
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXSoftmax
+ * @{
+ */
+
+/* exp(-d / 256) in Q15 for the scaled difference d >= 0 to the maximum logit */
+static inline uint32_t __exp_neg_q15(uint32_t diff, const int32_t m_zero, const int8_t n_zero1, const int8_t n_zero2)
+{
+    static const uint16_t exp_int[${len(exp_int)}] = {${", ".join(str(v) for v in exp_int)}};
+    static const uint16_t exp_hi[16] = {${", ".join(str(v) for v in exp_hi)}};
+    static const uint16_t exp_lo[16] = {${", ".join(str(v) for v in exp_lo)}};
+    int32_t d;
+
+    /* large differences saturate, their exponential is 0 anyway */
+    if (diff > (0x7FFFFFFFu >> n_zero1))
+    {
+        return 0;
+    }
+    d = (__HI_SMULL((int32_t) diff << n_zero1, m_zero)) >> n_zero2;
+    if (d >= ${len(exp_int) * 256})
+    {
+        return 0;
+    }
+    return (((exp_int[d >> 8] * exp_hi[(d >> 4) & 0x0F]) >> 15) * exp_lo[d & 0x0F]) >> 15;
+}
+
+  /**
+   * @brief Integer softmax (in: ${config.in_data_t}, out: u8)
+   *
+   * @param[in]       pSrc        pointer to the logits
+   * @param[in,out]   pOut        pointer to the u8 probabilities, 1/256 units
+   * @param[in]       size        number of logits, at most 131071
+   * @param[in]       m_zero      m quantization param of the exponent
+   * @param[in]       n_zero      n quantization param of the exponent
+   * @return     The function returns either
+   * <code>ARM_MATH_ARGUMENT_ERROR</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * out = exp(-d / 256) / sum(exp(-d / 256)) * 256, saturated to 255, where d is the difference of
+   * the maximum logit and the logit scaled by (m_zero, n_zero) as in the ICN normalization, i.e.
+   * (m_zero, n_zero) represent beta times the logits scale times 256. The input offset cancels out.
+   * The exponentials are built in Q15 from three tables (integer part, 1/16 and 1/256 of the
+   * exponent) and normalized with one reciprocal of their sum, no floating point nor division
+   * per element.
+% if config.in_data_t == 'u8':
+   * The maximum is searched 4 logits at a time with SIMD instructions and the probabilities are
+   * stored a 32-bit word at a time.
+% elif config.in_data_t == 'u4':
+   * The maximum is searched 8 packed logits at a time with SIMD instructions. A u4 logit takes
+   * 16 values only: their exponentials and probabilities are computed once, then the logits are
+   * only looked up.
+% endif
+   */
+arm_status
+${config.fn_name}(const ${in_ptr_t} *pSrc,
+                    uint8_t *pOut,
+                    const cmixnn_dim_t size,
+                    const int32_t m_zero,
+                    const int8_t n_zero)
+{
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+% if config.in_data_t != 'int32':
+    const uint8_t *pIn = pSrc;
+    uint8_t *pDst = pOut;
+    uint32_t in, vmax = 0;
+% endif
+% if config.in_data_t == 'u4':
+    uint32_t lo, hi;
+    int32_t v;
+    uint32_t exps[16];
+    uint32_t probs[16];
+% endif
+% if config.in_data_t != 'int32':
+    cmixnn_dim_t blkCnt;
+% endif
+    cmixnn_dim_t i_el;
+    int32_t max;
+    uint32_t sum = 0;
+% if config.in_data_t != 'u4':
+    uint32_t e;
+% endif
+    uint32_t recip;
+    int32_t shift;
+    int8_t n_zero1, n_zero2;
+
+#ifdef CMIXNN_LARGE_TENSORS
+    if (size <= 0 || size > 0x1FFFF)
+    {
+        /* the sum of the Q15 exponentials must fit 32 bits */
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+#else
+    /* at most 65535 logits: the sum of the Q15 exponentials stays below 2^31 */
+    if (size == 0)
+    {
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+#endif
+
+    __n_zero_negative_normalization(n_zero, &n_zero1, &n_zero2);
+
+% if config.in_data_t == 'u8':
+    /* maximum logit, 4 logits per word */
+    blkCnt = size >> 2;
+    while (blkCnt > 0)
+    {
+        in = *__SIMD32(pIn)++;
+        __USUB8(in, vmax);
+        vmax = __SEL(in, vmax);
+        blkCnt--;
+    }
+    __USUB8(vmax, vmax >> 16);
+    vmax = __SEL(vmax, vmax >> 16);
+    __USUB8(vmax, vmax >> 8);
+    vmax = __SEL(vmax, vmax >> 8);
+    max = vmax & 0xFF;
+    for (i_el = size & ~0x3; i_el < size; i_el++)
+    {
+        if (pSrc[i_el] > max)
+        {
+            max = pSrc[i_el];
+        }
+    }
+
+    /* sum of the exponentials */
+    for (i_el = 0; i_el < size; i_el++)
+    {
+        sum += __exp_neg_q15(max - pSrc[i_el], m_zero, n_zero1, n_zero2);
+    }
+% elif config.in_data_t == 'u4':
+    /* maximum logit, 8 logits per word: the even and odd logits in the bytes of lo and hi */
+    blkCnt = size >> 3;
+    while (blkCnt > 0)
+    {
+        in = *__SIMD32(pIn)++;
+        lo = in & 0x0F0F0F0F;
+        hi = (in >> 4) & 0x0F0F0F0F;
+        __USUB8(lo, vmax);
+        vmax = __SEL(lo, vmax);
+        __USUB8(hi, vmax);
+        vmax = __SEL(hi, vmax);
+        blkCnt--;
+    }
+    __USUB8(vmax, vmax >> 16);
+    vmax = __SEL(vmax, vmax >> 16);
+    __USUB8(vmax, vmax >> 8);
+    vmax = __SEL(vmax, vmax >> 8);
+    max = vmax & 0xFF;
+    for (i_el = size & ~0x7; i_el < size; i_el++)
+    {
+        v = (pSrc[i_el >> 1] >> ((i_el & 0x1) << 2)) & 0x0F;
+        if (v > max)
+        {
+            max = v;
+        }
+    }
+
+    /* exponentials of the 16 values, then their sum over the logits */
+    for (v = 0; v < 16; v++)
+    {
+        exps[v] = v <= max ? __exp_neg_q15(max - v, m_zero, n_zero1, n_zero2) : 0;
+    }
+    pIn = pSrc;
+    blkCnt = size >> 3;
+    while (blkCnt > 0)
+    {
+        in = *__SIMD32(pIn)++;
+%   for k in range(8):
+        sum += exps[(in >> ${4 * k}) & 0x0F];
+%   endfor
+        blkCnt--;
+    }
+    for (i_el = size & ~0x7; i_el < size; i_el++)
+    {
+        sum += exps[(pSrc[i_el >> 1] >> ((i_el & 0x1) << 2)) & 0x0F];
+    }
+% else:
+    /* maximum logit */
+    max = pSrc[0];
+    for (i_el = 1; i_el < size; i_el++)
+    {
+        if (pSrc[i_el] > max)
+        {
+            max = pSrc[i_el];
+        }
+    }
+
+    /* sum of the exponentials */
+    for (i_el = 0; i_el < size; i_el++)
+    {
+        sum += __exp_neg_q15((uint32_t) max - (uint32_t) pSrc[i_el], m_zero, n_zero1, n_zero2);
+    }
+% endif
+
+    /* reciprocal of the sum (>= 2^15): the 16 leading bits of the normalized sum are divided once,
+       then out = (e * recip) >> (40 - shift) = e * 256 / sum */
+    shift = __CLZ(sum);
+    recip = 0xFFFFFFFFu / ((sum << shift) >> 16);
+
+% if config.in_data_t == 'u8':
+    /* normalization, 4 probabilities per word */
+    blkCnt = size >> 2;
+    pIn = pSrc;
+    while (blkCnt > 0)
+    {
+        in = *__SIMD32(pIn)++;
+        vmax = 0;
+%   for k in range(4):
+        e = __exp_neg_q15(max - ((in >> ${8 * k}) & 0xFF), m_zero, n_zero1, n_zero2);
+        vmax |= __USAT((int32_t) ((((uint64_t) e * recip) + ((uint64_t) 1 << (39 - shift))) >> (40 - shift)), 8) << ${8 * k};
+%   endfor
+        *__SIMD32(pDst)++ = vmax;
+        blkCnt--;
+    }
+    for (i_el = size & ~0x3; i_el < size; i_el++)
+    {
+        e = __exp_neg_q15(max - pSrc[i_el], m_zero, n_zero1, n_zero2);
+        pOut[i_el] = (uint8_t) __USAT((int32_t) ((((uint64_t) e * recip) + ((uint64_t) 1 << (39 - shift))) >> (40 - shift)), 8);
+    }
+% elif config.in_data_t == 'u4':
+    /* probabilities of the 16 values, then 8 logits looked up per input word */
+    for (v = 0; v < 16; v++)
+    {
+        probs[v] = __USAT((int32_t) ((((uint64_t) exps[v] * recip) + ((uint64_t) 1 << (39 - shift))) >> (40 - shift)), 8);
+    }
+    pIn = pSrc;
+    blkCnt = size >> 3;
+    while (blkCnt > 0)
+    {
+        in = *__SIMD32(pIn)++;
+        *__SIMD32(pDst)++ = probs[in & 0x0F] | (probs[(in >> 4) & 0x0F] << 8)
+                          | (probs[(in >> 8) & 0x0F] << 16) | (probs[(in >> 12) & 0x0F] << 24);
+        *__SIMD32(pDst)++ = probs[(in >> 16) & 0x0F] | (probs[(in >> 20) & 0x0F] << 8)
+                          | (probs[(in >> 24) & 0x0F] << 16) | (probs[in >> 28] << 24);
+        blkCnt--;
+    }
+    for (i_el = size & ~0x7; i_el < size; i_el++)
+    {
+        pOut[i_el] = (uint8_t) probs[(pSrc[i_el >> 1] >> ((i_el & 0x1) << 2)) & 0x0F];
+    }
+% else:
+    /* normalization */
+    for (i_el = 0; i_el < size; i_el++)
+    {
+        e = __exp_neg_q15((uint32_t) max - (uint32_t) pSrc[i_el], m_zero, n_zero1, n_zero2);
+        pOut[i_el] = (uint8_t) __USAT((int32_t) ((((uint64_t) e * recip) + ((uint64_t) 1 << (39 - shift))) >> (40 - shift)), 8);
+    }
+% endif
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXSoftmax group
+ */
@@ -0,0 +1,241 @@
+<%!
+    bits = {'u8': 8, 'u4': 4, 'u2': 2}
+    lsb = {'u8': '0x01010101', 'u4': '0x11111111', 'u2': '0x55555555'}
+    msb = {'u8': '0x80808080', 'u4': '0x88888888', 'u2': '0xAAAAAAAA'}
+    lane_mask = {'u8': '0xFFFFFFFF', 'u4': '0x0F0F0F0F', 'u2': '0x03030303'}
+%>\
+<%def name="get_el(ptr, data_t)">\
+% if data_t == 'u8':
+${ptr}[i_el]\
+% elif data_t == 'u4':
+((${ptr}[i_el >> 1] >> ((i_el & 0x1) << 2)) & 0x0F)\
+% else:
+((${ptr}[i_el >> 2] >> ((i_el & 0x3) << 1)) & 0x03)\
+% endif
+</%def>\
+<%
+    in_bits = bits[config.in_data_t]
+    per_word = 32 // in_bits
+    # the logits of a word spread over the bytes of 8 / in_bits lane groups
+    shifts = list(range(0, 8, in_bits))
+%>\
+${config.header_top}
+% if config.op == "argmax":
+ * Description:  Argmax of packed ${config.in_data_t} logits.
+% else:
+ * Description:  Top-k of packed ${config.in_data_t} logits.
+% endif
+${config.header_bottom}
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXSoftmax
+ * @{
+ */
+
+% if config.op == "topk":
+/* insert a logit above the k-th best one, the equal logits keep their order of index */
+static inline int32_t __topk_insert(uint8_t *pVal, cmixnn_dim_t *pIndex, cmixnn_dim_t *cnt, const cmixnn_dim_t k,
+                                    const uint8_t val, const cmixnn_dim_t index)
+{
+    cmixnn_dim_t i = *cnt < k ? (*cnt)++ : k - 1;
+
+    while (i > 0 && pVal[i - 1] < val)
+    {
+        pVal[i] = pVal[i - 1];
+        pIndex[i] = pIndex[i - 1];
+        i--;
+    }
+    pVal[i] = val;
+    pIndex[i] = index;
+
+    /* the k-th best logit, -1 until k logits are found */
+    return *cnt < k ? -1 : pVal[k - 1];
+}
+
+% endif
+  /**
+% if config.op == "argmax":
+   * @brief Argmax of packed logits (in: ${config.in_data_t})
+% else:
+   * @brief Top-k of packed logits (in: ${config.in_data_t})
+% endif
+   *
+   * @param[in]       pSrc        pointer to the packed logits
+   * @param[in]       size        number of logits
+% if config.op == "argmax":
+   * @param[out]      pMax        maximum logit
+   * @param[out]      pIndex      index of the maximum logit, the lowest one on a tie
+% else:
+   * @param[in]       k           number of logits to select, 1 to size
+   * @param[out]      pVal        k best logits, in decreasing order
+   * @param[out]      pIndex      k indices of the best logits, the lowest ones first on a tie
+% endif
+   * @return     The function returns either
+   * <code>ARM_MATH_ARGUMENT_ERROR</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+% if config.op == "argmax":
+   * The logits are never unpacked: the maximum is searched ${per_word} logits at a time with SIMD byte
+   * compares${"" if in_bits == 8 else " on the " + str(len(shifts)) + " masked lane groups of each word"}, then the first word holding
+   * the maximum is found comparing whole words to the replicated maximum, and the zero lane of
+   * their xor gives the index.
+% else:
+   * The logits are never unpacked: ${per_word} logits at a time are compared to the k-th best logit so
+   * far with SIMD byte compares${"" if in_bits == 8 else " on the " + str(len(shifts)) + " masked lane groups of each word"}, and only the words
+   * holding a better logit are inserted one logit at a time. The scan stops once the k-th best
+   * logit is the largest ${config.in_data_t} value.
+% endif
+   */
+arm_status
+% if config.op == "argmax":
+${config.fn_name}(const uint8_t *pSrc,
+                    const cmixnn_dim_t size,
+                    uint8_t *pMax,
+                    cmixnn_dim_t *pIndex)
+% else:
+${config.fn_name}(const uint8_t *pSrc,
+                    const cmixnn_dim_t size,
+                    const cmixnn_dim_t k,
+                    uint8_t *pVal,
+                    cmixnn_dim_t *pIndex)
+% endif
+{
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    const uint8_t *pIn = pSrc;
+    uint32_t in;
+% if in_bits != 8:
+    uint32_t lanes;
+% endif
+    cmixnn_dim_t i_word, i_el;
+    const cmixnn_dim_t num_words = size / ${per_word};
+% if config.op == "argmax":
+    uint32_t vmax = 0, rep, t, flags;
+    uint8_t max;
+
+    if (size == 0)
+    {
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+
+    /* maximum logit, ${per_word} logits per word */
+    for (i_word = 0; i_word < num_words; i_word++)
+    {
+        in = *__SIMD32(pIn)++;
+%   if in_bits == 8:
+        __USUB8(in, vmax);
+        vmax = __SEL(in, vmax);
+%   else:
+%     for s in shifts:
+        lanes = ${"in" if s == 0 else "(in >> " + str(s) + ")"} & ${lane_mask[config.in_data_t]};
+        __USUB8(lanes, vmax);
+        vmax = __SEL(lanes, vmax);
+%     endfor
+%   endif
+    }
+    __USUB8(vmax, vmax >> 16);
+    vmax = __SEL(vmax, vmax >> 16);
+    __USUB8(vmax, vmax >> 8);
+    vmax = __SEL(vmax, vmax >> 8);
+    max = vmax & 0xFF;
+    for (i_el = num_words * ${per_word}; i_el < size; i_el++)
+    {
+        if (${get_el("pSrc", config.in_data_t)} > max)
+        {
+            max = ${get_el("pSrc", config.in_data_t)};
+        }
+    }
+    *pMax = max;
+
+    /* first word holding the maximum: the lowest zero lane of its xor with the replicated maximum
+       is exact, the borrows of the subtraction only flag the lanes above it */
+    rep = max * ${lsb[config.in_data_t]}u;
+    pIn = pSrc;
+    for (i_word = 0; i_word < num_words; i_word++)
+    {
+        t = *__SIMD32(pIn)++ ^ rep;
+        flags = (t - ${lsb[config.in_data_t]}u) & ~t & ${msb[config.in_data_t]}u;
+        if (flags)
+        {
+            *pIndex = i_word * ${per_word} + __CLZ(__RBIT(flags)) / ${in_bits};
+            return ARM_MATH_SUCCESS;
+        }
+    }
+    for (i_el = num_words * ${per_word}; i_el < size; i_el++)
+    {
+        if (${get_el("pSrc", config.in_data_t)} == max)
+        {
+            *pIndex = i_el;
+            break;
+        }
+    }
+% else:
+    uint32_t hit;
+    cmixnn_dim_t cnt = 0;
+    uint8_t val;
+    /* k-th best logit so far, -1 until k logits are found */
+    int32_t thr = -1;
+
+    if (k == 0 || k > size)
+    {
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+
+    for (i_word = 0; i_word < num_words && thr < ${2 ** in_bits - 1}; i_word++)
+    {
+        in = *__SIMD32(pIn)++;
+
+        /* any logit of the word above the k-th best one */
+%   if in_bits == 8:
+        __USUB8(in, (uint32_t) (thr + 1) * 0x01010101u);
+        hit = __SEL(0xFFFFFFFFu, 0);
+%   else:
+        hit = 0;
+%     for s in shifts:
+        lanes = ${"in" if s == 0 else "(in >> " + str(s) + ")"} & ${lane_mask[config.in_data_t]};
+        __USUB8(lanes, (uint32_t) (thr + 1) * 0x01010101u);
+        hit |= __SEL(0xFFFFFFFFu, 0);
+%     endfor
+%   endif
+        if (hit)
+        {
+            for (i_el = 0; i_el < ${per_word}; i_el++)
+            {
+                val = (in >> (i_el * ${in_bits})) & ${2 ** in_bits - 1};
+                if (val > thr)
+                {
+                    thr = __topk_insert(pVal, pIndex, &cnt, k, val, i_word * ${per_word} + i_el);
+                }
+            }
+        }
+    }
+    for (i_el = num_words * ${per_word}; i_el < size && thr < ${2 ** in_bits - 1}; i_el++)
+    {
+        val = ${get_el("pSrc", config.in_data_t)};
+        if (val > thr)
+        {
+            thr = __topk_insert(pVal, pIndex, &cnt, k, val, i_el);
+        }
+    }
+% endif
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXSoftmax group
+ */
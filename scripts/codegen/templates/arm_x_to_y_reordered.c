@@ -1,3 +1,15 @@
+<%
+    # signed inputs are read with their sign bits flipped, i.e. as unsigned values biased by half of
+    # their range, and the bias is added to the offset
+    in_t = config.in_data_t.replace('s', 'u')
+    if config.in_signed:
+        bias, sign_mask = {'s8': (128, "0x80808080"), 's4': (8, "0x88888888"), 's2': (2, "0xAAAAAAAA")}[config.in_data_t]
+        offset_init = "offset + {0}".format(bias)
+        read_in = "*__SIMD32(pIn)++ ^ {0}".format(sign_mask)
+    else:
+        offset_init = "offset"
+        read_in = "*__SIMD32(pIn)++"
+%>\
  ${config.header_top}
  * Description:  Converts the elements of ${config.in_data_t} vector to
  *               a reordered ${config.out_data_t} vector (without left-shift).
@@ -29,48 +41,48 @@ ${config.fn_name}(
 		const uint8_t *pSrc,
 		int16_t *pDst,
 		uint32_t blockSize,
-	    const uint8_t offset)
+	    const ${config.z_in_t} offset)
 {
     const uint8_t *pIn = pSrc;  /* Src pointer */
     uint32_t  blkCnt;           /* loop counter */
-    int16_t offsets[2] = {offset, offset};
+    int16_t offsets[2] = {${offset_init}, ${offset_init}};
     const int16_t *offset_ptr = offsets;
 
 #ifndef ARM_MATH_CM0_FAMILY
     int32_t   in;
-% if config.in_data_t=='u8':
+% if in_t=='u8':
     int32_t   in1, in2;
-% elif config.in_data_t=='u4':
+% elif in_t=='u4':
     int32_t   in1, in2, in3, in4;
-% elif config.in_data_t=='u2':
+% elif in_t=='u2':
     int32_t   in1, in2, in3, in4, in5, in6, in7, in8;
 % endif
     int32_t   offset_vect = *__SIMD32(offset_ptr);
 
     /*loop Unrolling */
-% if config.in_data_t=='u8':
+% if in_t=='u8':
     blkCnt = blockSize >> 2u; // 4-elements block
-% elif config.in_data_t=='u4':
+% elif in_t=='u4':
     blkCnt = blockSize >> 3u; // 8-elements block
-% elif config.in_data_t=='u2':
+% elif in_t=='u2':
     blkCnt = blockSize >> 4u; // 16-elements block
 % endif
 
     /* First part of the processing with loop unrolling.
        Second loop below computes the leftover */
-    if(offset)
+    if(offset_vect)
     {
 		while (blkCnt > 0u)
 		{
-			in = *__SIMD32(pIn)++;
+			in = ${read_in};
 
-% if config.in_data_t=='u8':
+% if in_t=='u8':
 			in1 = __UXTB16(__ROR(in, 8));
 			in2 = __UXTB16(in);
 
             in1 = __SSUB16(in1, offset_vect);
 	        in2 = __SSUB16(in2, offset_vect);
-% elif config.in_data_t=='u4':
+% elif in_t=='u4':
             in4 = __UXTB16(__ROR(__UXTB16( in << 4), 4));
             in3 = __UXTB16(__ROR(__UXTB16( in     ), 4));
             in2 = __UXTB16(__ROR(__UXTB16( in >> 4), 4));
@@ -80,7 +92,7 @@ ${config.fn_name}(
 	        in3 = __SSUB16(in3, offset_vect);
             in2 = __SSUB16(in2, offset_vect);
 	        in1 = __SSUB16(in1, offset_vect);
-% elif config.in_data_t=='u2':
+% elif in_t=='u2':
             in8 = __UXTB16(__ROR(__UXTB16( in << 6), 6));
             in7 = __UXTB16(__ROR(__UXTB16( in << 4), 6));
             in6 = __UXTB16(__ROR(__UXTB16( in << 2), 6));
@@ -102,15 +114,15 @@ ${config.fn_name}(
 % endif
 
 #ifndef ARM_MATH_BIG_ENDIAN
-% if config.in_data_t=='u8':
+% if in_t=='u8':
             *__SIMD32(pDst)++ = in2;
             *__SIMD32(pDst)++ = in1;
-% elif config.in_data_t=='u4':
+% elif in_t=='u4':
             *__SIMD32(pDst)++ = in4;
             *__SIMD32(pDst)++ = in3;
             *__SIMD32(pDst)++ = in2;
             *__SIMD32(pDst)++ = in1;
-% elif config.in_data_t=='u2':
+% elif in_t=='u2':
             *__SIMD32(pDst)++ = in8;
             *__SIMD32(pDst)++ = in7;
             *__SIMD32(pDst)++ = in6;
@@ -121,15 +133,15 @@ ${config.fn_name}(
             *__SIMD32(pDst)++ = in1;
 % endif
 #else
-% if config.in_data_t=='u8':
+% if in_t=='u8':
             *__SIMD32(pDst)++ = in1;
             *__SIMD32(pDst)++ = in2;
-% elif config.in_data_t=='u4':
+% elif in_t=='u4':
             *__SIMD32(pDst)++ = in1;
             *__SIMD32(pDst)++ = in2;
             *__SIMD32(pDst)++ = in3;
             *__SIMD32(pDst)++ = in4;
-% elif config.in_data_t=='u2':
+% elif in_t=='u2':
             *__SIMD32(pDst)++ = in1;
             *__SIMD32(pDst)++ = in2;
             *__SIMD32(pDst)++ = in3;
@@ -148,17 +160,17 @@ ${config.fn_name}(
     {
 		while (blkCnt > 0u)
 		{
-			in = *__SIMD32(pIn)++;
+			in = ${read_in};
 
-% if config.in_data_t=='u8':
+% if in_t=='u8':
 			in1 = __UXTB16(__ROR(in, 8));
 			in2 = __UXTB16(in);
-% elif config.in_data_t=='u4':
+% elif in_t=='u4':
             in4 = __UXTB16(__ROR(__UXTB16( in << 4), 4));
             in3 = __UXTB16(__ROR(__UXTB16( in     ), 4));
             in2 = __UXTB16(__ROR(__UXTB16( in >> 4), 4));
             in1 = __UXTB16(__ROR(__UXTB16( in >> 8), 4));
-% elif config.in_data_t=='u2':
+% elif in_t=='u2':
             in8 = __UXTB16(__ROR(__UXTB16( in << 6), 6));
             in7 = __UXTB16(__ROR(__UXTB16( in << 4), 6));
             in6 = __UXTB16(__ROR(__UXTB16( in << 2), 6));
@@ -171,15 +183,15 @@ ${config.fn_name}(
 % endif
 
 #ifndef ARM_MATH_BIG_ENDIAN
-% if config.in_data_t=='u8':
+% if in_t=='u8':
             *__SIMD32(pDst)++ = in2;
             *__SIMD32(pDst)++ = in1;
-% elif config.in_data_t=='u4':
+% elif in_t=='u4':
             *__SIMD32(pDst)++ = in4;
             *__SIMD32(pDst)++ = in3;
             *__SIMD32(pDst)++ = in2;
             *__SIMD32(pDst)++ = in1;
-% elif config.in_data_t=='u2':
+% elif in_t=='u2':
             *__SIMD32(pDst)++ = in8;
             *__SIMD32(pDst)++ = in7;
             *__SIMD32(pDst)++ = in6;
@@ -190,15 +202,15 @@ ${config.fn_name}(
             *__SIMD32(pDst)++ = in1;
 % endif
 #else
-% if config.in_data_t=='u8':
+% if in_t=='u8':
             *__SIMD32(pDst)++ = in1;
             *__SIMD32(pDst)++ = in2;
-% elif config.in_data_t=='u4':
+% elif in_t=='u4':
             *__SIMD32(pDst)++ = in1;
             *__SIMD32(pDst)++ = in2;
             *__SIMD32(pDst)++ = in3;
             *__SIMD32(pDst)++ = in4;
-% elif config.in_data_t=='u2':
+% elif in_t=='u2':
             *__SIMD32(pDst)++ = in1;
             *__SIMD32(pDst)++ = in2;
             *__SIMD32(pDst)++ = in3;
@@ -216,33 +228,48 @@ ${config.fn_name}(
     }
 
     /* If the blockSize is not a multiple, compute any remaining output samples here.
-     ** No loop unrolling is used. */
-% if config.in_data_t=='u8':
+     ** No loop unrolling is used, leftover samples are not reordered. */
+% if in_t=='u8':
     blkCnt = blockSize % 0x4u;
-% elif config.in_data_t=='u4':
+% elif in_t=='u4':
     blkCnt = blockSize % 0x8u;
-% elif config.in_data_t=='u2':
-    blkCnt = blockSize % 0x16u;
+% elif in_t=='u2':
+    blkCnt = blockSize % 0x10u;
 % endif
 #else
 #error "Cortex-M0 is not supported"
 #endif /* #ifndef ARM_MATH_CM0_FAMILY */
 
-% if config.in_data_t=='u4' or config.in_data_t=='u2':
-    int32_t in_32 = *((int32_t *)  pIn);
+% if in_t=='u4' or in_t=='u2':
+    uint32_t shift = 0;
 % endif
 
     while (blkCnt > 0u)
     {
 % if config.in_data_t=='u8':
         *pDst++ = ((int16_t) * pIn++)-offset;
+% elif config.in_data_t=='s8':
+        *pDst++ = ((int16_t) (int8_t) * pIn++)-offset;
+% elif config.in_data_t=='s4':
+        *pDst++ = ((int16_t) (((int8_t) (*pIn << (4 - shift))) >> 4))-offset;
+        shift += 4;
+% elif config.in_data_t=='s2':
+        *pDst++ = ((int16_t) (((int8_t) (*pIn << (6 - shift))) >> 6))-offset;
+        shift += 2;
 % elif config.in_data_t=='u4':
-        *pDst++ = (int16_t) __UXTB16(__ROR(__UXTB16( in_32 << 4), 4));
-        in_32 = __ROR(in_32, 4);
-
+        *pDst++ = ((int16_t) ((*pIn >> shift) & 0x0F))-offset;
+        shift += 4;
 % elif config.in_data_t=='u2':
-        *pDst++ = (int16_t) __UXTB16(__ROR(__UXTB16( in_32 << 6), 6));
-        in_32 = __ROR(in_32, 2);
+        *pDst++ = ((int16_t) ((*pIn >> shift) & 0x03))-offset;
+        shift += 2;
+% endif
+% if in_t=='u4' or in_t=='u2':
+        if (shift == 8)
+        {
+            /* move to the next byte, reading only the bytes of the vector */
+            shift = 0;
+            pIn++;
+        }
 % endif
 
         /* Decrement the loop counter */
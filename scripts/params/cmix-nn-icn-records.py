@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+#
+# Packs the per-channel ICN parameters of the layers into the requantization records
+# (cmixnn_icn_rec_t) taken by the *_PACT_CH_icn_rec kernels, and writes them as C arrays.
+#
+# The input is a JSON file with a list of layers, each one with a name and the per-output
+# channel bias, m_zero, n_zero and z_wt lists of the *_PACT_CH_icn kernels:
+#
+#   {"layers": [{"name": "conv1", "bias": [...], "m_zero": [...], "n_zero": [...], "z_wt": [...]}]}
+#
+# m_zero takes the whole int32_t range: a negative m_zero (ICN folding of a negative BN gamma) is
+# supported by the kernels like in the *_PACT_CH_icn ones.
+#
+# The n_zero normalization of the kernels is done here: n_zero1 = -n_zero if n_zero <= 0 (left
+# shift), n_zero2 = n_zero if n_zero > 0 (right shift). z_wt is repeated in both halfwords.
+
+import argparse
+import json
+import sys
+
+
+def CMixNNIcnRecord(bias, m_zero, n_zero, z_wt):
+    """Fields of a cmixnn_icn_rec_t: bias, m_zero, z_wt, n_zero1, n_zero2, reserved"""
+    if not -2 ** 31 <= bias < 2 ** 31 or not -2 ** 31 <= m_zero < 2 ** 31:
+        raise ValueError("bias or m_zero out of the int32_t range")
+    if not -31 <= n_zero <= 31 or not 0 <= z_wt <= 255:
+        raise ValueError("n_zero or z_wt out of range")
+    n_zero1, n_zero2 = (0, n_zero) if n_zero > 0 else (-n_zero, 0)
+    return (bias, m_zero, z_wt | (z_wt << 16), n_zero1, n_zero2, 0)
+
+
+def CMixNNIcnRecords(layer):
+    fields = [layer[k] for k in ('bias', 'm_zero', 'n_zero', 'z_wt')]
+    if len(set(len(f) for f in fields)) != 1:
+        raise ValueError("{0}: bias, m_zero, n_zero and z_wt have different lengths".format(layer['name']))
+    return [CMixNNIcnRecord(*ch) for ch in zip(*fields)]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Pack the ICN parameters into cmixnn_icn_rec_t arrays')
+    parser.add_argument('params', help='JSON file with the per-channel bias, m_zero, n_zero and z_wt of the layers')
+    parser.add_argument('-o', '--output', default='cmixnn_icn_records.c', help='C file to write')
+    args = parser.parse_args()
+
+    with open(args.params) as f:
+        layers = json.load(f)['layers']
+
+    src = '#include "arm_cmixnn.h"\n'
+    for layer in layers:
+        try:
+            records = CMixNNIcnRecords(layer)
+        except ValueError as e:
+            print("error: {0}".format(e), file=sys.stderr)
+            return 1
+        src += "\n/* {0}: {1} output channels */\n".format(layer['name'], len(records))
+        src += "const cmixnn_icn_rec_t {0}_ch_params[{1}] __ALIGNED(8) = {{\n".format(layer['name'], len(records))
+        src += "".join("    {{{0}, {1}, 0x{2:08X}, {3}, {4}, {5}}},\n".format(*r) for r in records)
+        src += "};\n"
+
+    with open(args.output, 'w') as f:
+        f.write(src)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+#
+# Lists the layers whose requantization scale is a power of two, so that they can use the
+# shift-only (pow2) kernels, and prints the n_zero right shift of each of them.
+#
+# The input is a JSON file with a list of layers, each one with a name and either the real
+# scale of the output (scale = S_in * S_wt / S_out) or the m_zero/n_zero pair of the
+# weights/icn kernels (scalars, or per-output channel lists):
+#
+#   {"layers": [{"name": "conv1", "scale": 0.0078125},
+#               {"name": "conv2", "m_zero": 1073741824, "n_zero": 3}]}
+#
+# The weights/icn kernels compute ((sum << n_zero1) * m_zero) >> (32 + n_zero2), that is a
+# scale of m_zero * 2^-(32 + n_zero): when m_zero is a power of two 2^p the same scale is a
+# right shift by 32 + n_zero - p. The pow2 kernels round to nearest instead of truncating.
+
+import argparse
+import json
+import math
+import sys
+
+CMixNNPow2MaxShift = 31
+
+
+def CMixNNPow2ShiftFromScale(scale, rel_tol=1e-6):
+    """Right shift equivalent to a real scale, None if the scale is not 2^-n with 0 <= n <= 31"""
+    if scale <= 0:
+        return None
+    shift = round(-math.log2(scale))
+    if not math.isclose(scale, 2.0 ** -shift, rel_tol=rel_tol, abs_tol=0.0):
+        return None
+    return shift if 0 <= shift <= CMixNNPow2MaxShift else None
+
+
+def CMixNNPow2ShiftFromMN(m_zero, n_zero):
+    """Right shift equivalent to a (m_zero, n_zero) pair, None if m_zero is not a power of two"""
+    if m_zero <= 0 or m_zero & (m_zero - 1):
+        return None
+    shift = 32 + n_zero - (m_zero.bit_length() - 1)
+    return shift if 0 <= shift <= CMixNNPow2MaxShift else None
+
+
+def CMixNNPow2Shift(layer):
+    """Right shift of a layer, None if some output channel has not the same power-of-two scale"""
+    if 'scale' in layer:
+        scales = layer['scale'] if isinstance(layer['scale'], list) else [layer['scale']]
+        shifts = [CMixNNPow2ShiftFromScale(s) for s in scales]
+    else:
+        m_zero = layer['m_zero'] if isinstance(layer['m_zero'], list) else [layer['m_zero']]
+        n_zero = layer['n_zero'] if isinstance(layer['n_zero'], list) else [layer['n_zero']] * len(m_zero)
+        shifts = [CMixNNPow2ShiftFromMN(m, n) for m, n in zip(m_zero, n_zero)]
+    if None in shifts or len(set(shifts)) != 1:
+        return None
+    return shifts[0]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='List the layers eligible to the pow2 (shift-only) kernels')
+    parser.add_argument('params', help='JSON file with the scales or m_zero/n_zero of the layers')
+    parser.add_argument('-o', '--output', help='write the layers with the pow2 n_zero of the eligible ones to a JSON file')
+    args = parser.parse_args()
+
+    with open(args.params) as f:
+        layers = json.load(f)['layers']
+
+    eligible = 0
+    for layer in layers:
+        shift = CMixNNPow2Shift(layer)
+        if shift is None:
+            print("{0:32} -".format(layer['name']))
+        else:
+            print("{0:32} pow2 n_zero={1}".format(layer['name'], shift))
+            layer['folding'] = 'pow2'
+            layer['pow2_n_zero'] = shift
+            eligible += 1
+    print("{0} of {1} layers can use the pow2 kernels".format(eligible, len(layers)))
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump({'layers': layers}, f, indent=2)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,180 @@
+/* Copyright (C) 2020 University of Bologna
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+ /******************************************************************
+ * Project:      CMixNN Inference Library
+ * Title:        arm_elementwise_add_u2_u2_u4.c
+ * Description:  Mixed Precision element-wise addition of u2 and
+ *               u2 tensors producing u4 output activations.
+ * Target:       ARM Cortex-M cores
+ *
+ * Date:         10 February 2020
+ * Revision:     Release v1.0.0
+ *
+ * Authors:      Alessandro Capotondi
+ *                 <alessandro.capotondi AT unibo.it>
+ *               Marco Fariselli
+ *                 <marco.fariselli AT greenwaves-technologies.com>
+ *               Manuele Rusci 
+ *                 <manuele.rusci AT unibo.it>
+ *
+ ******************************************************************/
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXBasicMath
+ * @{
+ */
+
+  /**
+   * @brief Mixed Precision element-wise addition (a: u2, b: u2, out: u4)
+   *
+   * @param[in]       pA          pointer to the first input tensor
+   * @param[in]       pB          pointer to the second input tensor
+   * @param[in,out]   pOut        pointer to the output tensor
+   * @param[in]       size        number of elements
+   * @param[in]       z_a         first input offset
+   * @param[in]       m_a         first input m quantization param
+   * @param[in]       n_a         first input n quantization param
+   * @param[in]       z_b         second input offset
+   * @param[in]       m_b         second input m quantization param
+   * @param[in]       n_b         second input n quantization param
+   * @param[in]       z_out       output offset
+   * @return     The function returns <code>ARM_MATH_SUCCESS</code>
+   *
+   * @details
+   *
+   * out = requant(a - z_a) + requant(b - z_b) + z_out, each input rescaled to the output by its own
+   * (m, n) pair as in the ICN normalization.
+   * The tensors are packed: 16 elements are processed per iteration, reading and writing whole
+   * 32-bit words. The inputs are expanded to int16_t pairs with SIMD instructions; the leftover
+   * elements are processed one by one.
+   */
+arm_status
+arm_elementwise_add_u2_u2_u4(const uint8_t *pA,
+                    const uint8_t *pB,
+                    uint8_t *pOut,
+                    const cmixnn_dim_t size,
+                    const uint8_t z_a,
+                    const int32_t m_a,
+                    const int8_t n_a,
+                    const uint8_t z_b,
+                    const int32_t m_b,
+                    const int8_t n_b,
+                    const uint8_t z_out)
+{
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    const uint8_t *pInA = pA;
+    const uint8_t *pInB = pB;
+    uint8_t *pDst = pOut;
+    int32_t bufA[8];
+    int32_t bufB[8];
+    int32_t *pBuf;
+    int32_t in1, in2, in3, in4, in5, in6, in7, in8;
+    int32_t sum;
+    uint32_t out_word;
+    cmixnn_dim_t blkCnt = size / 16;
+    cmixnn_dim_t i_el;
+    int16_t Vz_a[2] = {z_a, z_a};
+    int16_t Vz_b[2] = {z_b, z_b};
+    const int32_t *pz_a = (int32_t *) Vz_a;
+    const int32_t *pz_b = (int32_t *) Vz_b;
+    const int32_t z_a_vect = *__SIMD32(pz_a);
+    const int32_t z_b_vect = *__SIMD32(pz_b);
+    int8_t n_a1, n_a2, n_b1, n_b2;
+
+    __n_zero_negative_normalization(n_a, &n_a1, &n_a2);
+    __n_zero_negative_normalization(n_b, &n_b1, &n_b2);
+
+    while (blkCnt > 0u)
+    {
+        /* expand 16 elements of each input to int16_t, without the offsets */
+        pBuf = bufA;
+        pInA = read_and_pad_reordered_u2((void *) pInA, &in1, &in2, &in3, &in4, &in5, &in6, &in7, &in8);
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHBT(in1, in2, 16), z_a_vect);
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHBT(in3, in4, 16), z_a_vect);
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHBT(in5, in6, 16), z_a_vect);
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHBT(in7, in8, 16), z_a_vect);
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHTB(in2, in1, 16), z_a_vect);
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHTB(in4, in3, 16), z_a_vect);
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHTB(in6, in5, 16), z_a_vect);
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHTB(in8, in7, 16), z_a_vect);
+        pBuf = bufB;
+        pInB = read_and_pad_reordered_u2((void *) pInB, &in1, &in2, &in3, &in4, &in5, &in6, &in7, &in8);
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHBT(in1, in2, 16), z_b_vect);
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHBT(in3, in4, 16), z_b_vect);
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHBT(in5, in6, 16), z_b_vect);
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHBT(in7, in8, 16), z_b_vect);
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHTB(in2, in1, 16), z_b_vect);
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHTB(in4, in3, 16), z_b_vect);
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHTB(in6, in5, 16), z_b_vect);
+        *__SIMD32(pBuf)++ = __SSUB16(__PKHTB(in8, in7, 16), z_b_vect);
+
+        out_word = 0;
+        for (i_el = 0; i_el < 16; i_el += 2)
+        {
+            const int32_t a = bufA[i_el >> 1];
+            const int32_t b = bufB[i_el >> 1];
+
+            sum = ((__HI_SMULL(((int16_t) a) << n_a1, m_a)) >> n_a2)
+                + ((__HI_SMULL(((int16_t) b) << n_b1, m_b)) >> n_b2) + z_out;
+            out_word |= __USAT(sum, 4) << ((i_el & 7) * 4);
+            sum = ((__HI_SMULL((a >> 16) << n_a1, m_a)) >> n_a2)
+                + ((__HI_SMULL((b >> 16) << n_b1, m_b)) >> n_b2) + z_out;
+            out_word |= __USAT(sum, 4) << (((i_el + 1) & 7) * 4);
+
+            if (((i_el + 2) & 7) == 0)
+            {
+                /* a whole output word is ready */
+                *__SIMD32(pDst)++ = out_word;
+                out_word = 0;
+            }
+        }
+
+        /* Decrement the loop counter */
+        blkCnt--;
+    }
+
+    /* leftover elements */
+    for (i_el = size - size % 16; i_el < size; i_el++)
+    {
+        const int32_t a = ((pA[i_el >> 2] >> ((i_el & 0x3) << 1)) & 0x03) - z_a;
+        const int32_t b = ((pB[i_el >> 2] >> ((i_el & 0x3) << 1)) & 0x03) - z_b;
+
+        sum = ((__HI_SMULL(a << n_a1, m_a)) >> n_a2) + ((__HI_SMULL(b << n_b1, m_b)) >> n_b2) + z_out;
+        pOut[i_el >> 1] = (pOut[i_el >> 1] & ~(0x0F << ((i_el & 0x1) << 2))) | (__USAT(sum, 4) << ((i_el & 0x1) << 2));
+    }
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXBasicMath group
+ */
@@ -0,0 +1,219 @@
+/* Copyright (C) 2020 University of Bologna
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+ /******************************************************************
+ * Project:      CMixNN Inference Library
+ * Title:        arm_convolve_HWC_s2_int16_u4.c
+ * Description:  Mixed Precision Convolutional function that uses s2
+ *               activations, u4 weights and produce the raw int16
+ *               accumulators, with no requantization.
+ * Target:       ARM Cortex-M cores
+ *
+ * Date:         10 February 2020
+ * Revision:     Release v1.0.0
+ *
+ * Authors:      Alessandro Capotondi
+ *                 <alessandro.capotondi AT unibo.it>
+ *               Marco Fariselli
+ *                 <marco.fariselli AT greenwaves-technologies.com>
+ *               Manuele Rusci 
+ *                 <manuele.rusci AT unibo.it>
+ *
+ ******************************************************************/
+
+#include <assert.h>
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXConv
+ * @{
+ */
+
+  /**
+   * @brief Mixed Precision Convolution with raw int16 output (in: s2, wt: u4)
+   *
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimension
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       left_pad    padding sizes
+   * @param[in]       right_pad   padding sizes
+   * @param[in]       top_pad     padding sizes
+   * @param[in]       bottom_pad  padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   Im_out      pointer to output tensor, int16_t elements (2-byte aligned)
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       z_in        input offset
+   * @param[in]       z_wt        weights offset
+   * @param[in]       n_zero      right shift of the accumulators, 0 to 31
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   bufferB     pointer to buffer space for the sums of a pixel pair, 2*ch_im_out int32_t (32-bit aligned)
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * The output is the accumulator of each output channel, bias included, rounded and shifted
+   * right by n_zero and saturated to int16_t: out = __SSAT((sum + 2^(n_zero-1)) >> n_zero, 16).
+   * The pixel pairs are computed with the int32_t Matrix-Multiplication into bufferB.
+   * The weights have the same layout as the plain convolution.
+   */
+arm_status
+arm_convolve_HWC_s2_int16_u4(const uint8_t *Im_in,
+                    const cmixnn_dim_t dim_im_in,
+                    const cmixnn_dim_t ch_im_in,
+                    const uint8_t *wt,
+                    const cmixnn_dim_t ch_im_out,
+                    const cmixnn_dim_t dim_kernel,
+                    const uint8_t left_padding,
+                    const uint8_t right_padding,
+                    const uint8_t top_padding,
+                    const uint8_t bottom_padding,
+                    const cmixnn_dim_t stride,
+                    const int32_t *bias,
+                    int16_t *Im_out,
+                    const cmixnn_dim_t dim_im_out,
+                    const int8_t z_in,
+                    const uint8_t z_wt,
+                    const int8_t n_zero,
+                    int16_t * bufferA,
+                    uint8_t *bufferB)
+{
+
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    cmixnn_idx_t i_out_y, i_out_x, i_ker_y, i_ker_x;
+    int16_t *pBuffer = bufferA;
+    int32_t *pSum = (int32_t *) bufferB;
+    const cmixnn_dim_t numCol = ch_im_in * dim_kernel * dim_kernel;
+    const int32_t num_pix = dim_im_out * dim_im_out;
+    int32_t i_pix;
+    cmixnn_dim_t i_ch, i_col;
+    int32_t i_el, el_end;
+    const int32_t n_round = (int32_t) ((1u << n_zero) >> 1);
+
+    if (ch_im_in % 4 != 0 || ch_im_out % 2 != 0)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    for (i_pix = 0; i_pix < num_pix; i_pix += 2)
+    {
+        /* This part implements the im2col function, a leftover pixel fills both columns */
+        pBuffer = bufferA;
+        for (i_col = 0; i_col < 2; i_col++)
+        {
+            i_out_y = (i_pix + (i_col && i_pix + 1 < num_pix)) / dim_im_out;
+            i_out_x = (i_pix + (i_col && i_pix + 1 < num_pix)) % dim_im_out;
+            if (ch_im_in % 16 != 0)
+            {
+                /* pixels do not fill whole vectors: gather the packed window, padded with z_in, and convert it at once */
+                arm_s2_to_int16_reordered(__im2col_gather(Im_in, dim_im_in, ch_im_in, ch_im_in, 2,
+                                                            i_out_y * stride - top_padding, i_out_x * stride - left_padding,
+                                                            dim_kernel, dim_kernel, 1, z_in, pBuffer, numCol),
+                                            pBuffer,
+                                            numCol,
+                                            z_in);
+                pBuffer += numCol;
+                continue;
+            }
+            for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+            {
+                if (i_ker_y < 0 || i_ker_y >= dim_im_in)
+                {
+                    memset(pBuffer, 0, sizeof(int16_t) * ch_im_in * dim_kernel);
+                    pBuffer += ch_im_in * dim_kernel;
+                }
+                else if (i_out_x * stride - left_padding >= 0
+                         && i_out_x * stride - left_padding + dim_kernel <= dim_im_in)
+                {
+                    /* the kernel row lies in the input: load it at once */
+                    arm_s2_to_int16_reordered(
+                                        Im_in + (((i_ker_y * dim_im_in + i_out_x * stride - left_padding) * ch_im_in) >> 2),
+                                        pBuffer,
+                                        ch_im_in * dim_kernel,
+                                        z_in);
+                    pBuffer += ch_im_in * dim_kernel;
+                }
+                else
+                {
+                    for (i_ker_x = i_out_x * stride - left_padding; i_ker_x < i_out_x * stride - left_padding + dim_kernel; i_ker_x++)
+                    {
+                        if (i_ker_x < 0 || i_ker_x >= dim_im_in)
+                        {
+                            memset(pBuffer, 0, sizeof(int16_t) * ch_im_in);
+                        }
+                        else
+                        {
+                            arm_s2_to_int16_reordered(
+                                        Im_in + (((i_ker_y * dim_im_in + i_ker_x) * ch_im_in) >> 2),
+                                        pBuffer,
+                                        ch_im_in,
+                                        z_in);
+                        }
+                        pBuffer += ch_im_in;
+                    }
+                }
+            }
+        }
+
+        /* sums of the pixel pair start from the bias */
+        for (i_ch = 0; i_ch < ch_im_out; i_ch++)
+        {
+            pSum[i_ch] = bias[i_ch];
+            pSum[ch_im_out + i_ch] = bias[i_ch];
+        }
+        arm_nn_mat_mult_kernel_partial_reordered_u4_int16_int32(wt,
+                                        bufferA,
+                                        ch_im_out,
+                                        numCol,
+                                        numCol,
+                                        numCol,
+                                        numCol,
+                                        pSum,
+                                        z_wt);
+
+        /* shift, saturate and store the pixel pair */
+        el_end = (i_pix + 1 < num_pix ? 2 : 1) * ch_im_out;
+        for (i_el = 0; i_el < el_end; i_el++)
+        {
+            Im_out[i_pix * ch_im_out + i_el] = (int16_t) __SSAT((pSum[i_el] + n_round) >> n_zero, 16);
+        }
+    }
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXConv group
+ */
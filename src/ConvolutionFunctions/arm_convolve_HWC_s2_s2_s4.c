@@ -0,0 +1,410 @@
+/* Copyright (C) 2020 University of Bologna
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+ /******************************************************************
+ * Project:      CMixNN Inference Library
+ * Title:        arm_convolve_HWC_s2_s2_s4.c
+ * Description:  Mixed Precision Convolutional function that uses s2
+ *               activations, s4 weights and produce s2
+ *               output activations. Outputs are quantized using weights
+ *               folding technique.
+ * Target:       ARM Cortex-M cores
+ *
+ * Date:         10 February 2020
+ * Revision:     Release v1.0.0
+ *
+ * Authors:      Alessandro Capotondi
+ *                 <alessandro.capotondi AT unibo.it>
+ *               Marco Fariselli
+ *                 <marco.fariselli AT greenwaves-technologies.com>
+ *               Manuele Rusci 
+ *                 <manuele.rusci AT unibo.it>
+ *
+ ******************************************************************/
+
+#include <assert.h>
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXConv
+ * @{
+ */
+
+  /**
+   * @brief Mixed Precision Convolution weights (in: s2, out: s2, wt: s4)
+   *
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimension
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       left_pad    padding sizes
+   * @param[in]       right_pad   padding sizes
+   * @param[in]       top_pad     padding sizes
+   * @param[in]       bottom_pad  padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       z_in        input offset
+   * @param[in]       z_out       output offset
+   * @param[in]       m_zero      m zero quantization param
+   * @param[in]       n_zero      n zero quantization param
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * ch_im_in must be a multiple of 4 and ch_im_out a multiple of 4, i.e., every pixel
+   * fills whole bytes. When ch_im_in is not a multiple of 16, the packed kernel window of an output pixel is
+   * gathered at the end of its bufferA column and converted at once, so that the column is reordered in the same
+   * 32-bit words as the filter rows of the weights.
+   *
+   * Output pixels whose receptive field overlaps the padding only multiply the kernel taps inside
+   * the input when ch_im_in is a multiple of 16, otherwise the whole kernel is used.
+   * right_padding and bottom_padding are implied by dim_im_out.
+   *
+   * The weights are signed and symmetric (s4, two's complement), no weights offset is subtracted.
+   *
+   * The input and output activations are signed (two's complement), with signed offsets.
+   *
+   * When stride < dim_kernel and ch_im_in is a multiple of 16, consecutive interior pixels of a row
+   * reuse the dim_kernel - stride columns they share, so every input column is converted once per kernel row.
+   */
+arm_status
+arm_convolve_HWC_s2_s2_s4(const uint8_t *Im_in,
+                    const cmixnn_dim_t dim_im_in,
+                    const cmixnn_dim_t ch_im_in,
+                    const uint8_t *wt,
+                    const cmixnn_dim_t ch_im_out,
+                    const cmixnn_dim_t dim_kernel,
+                    const uint8_t left_padding,
+                    const uint8_t right_padding,
+                    const uint8_t top_padding,
+                    const uint8_t bottom_padding,
+                    const cmixnn_dim_t stride,
+                    const int32_t *bias,
+                    uint8_t *Im_out,
+                    const cmixnn_dim_t dim_im_out,
+                    const int8_t z_in,
+                    const int8_t z_out,
+                    const int32_t m_zero,
+                    const int8_t n_zero,
+                    int16_t * bufferA,
+                    uint8_t *bufferB)
+{
+
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    cmixnn_idx_t i_out_y, i_out_x, i_ker_y, i_ker_x;
+    int16_t *pBuffer = bufferA;
+    uint8_t *pOut = Im_out;
+    /* spatial extent of the kernel and distance between its taps */
+    const cmixnn_idx_t dim_kernel_dil = dim_kernel;
+    const cmixnn_idx_t dilation = 1;
+    const cmixnn_dim_t numCol = ch_im_in * dim_kernel * dim_kernel;
+    int32_t i_pix, i_pix1 = 0;
+
+    if (ch_im_in % 4 != 0 || ch_im_out % 4 != 0)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    /* rows of the output computed by this call */
+    const cmixnn_idx_t out_y_begin = 0;
+    const cmixnn_idx_t out_y_end = dim_im_out;
+
+    /*
+     *  Here we split the output into the interior, whose receptive field lies inside the input,
+     *  and the border, whose receptive field overlaps the padding:
+     *    Top: i_out_y from out_y_begin to out_y_lo - 1
+     *   Left: i_out_x from 0 to out_x_lo - 1
+     *  Right: i_out_x from out_x_hi to dim_im_out - 1
+     * Bottom: i_out_y from out_y_hi to out_y_end - 1
+     */
+    cmixnn_idx_t out_y_lo = (top_padding + stride - 1) / stride;
+    cmixnn_idx_t out_x_lo = (left_padding + stride - 1) / stride;
+    cmixnn_idx_t out_y_hi = (dim_im_in + top_padding < dim_kernel_dil) ? 0 : (dim_im_in + top_padding - dim_kernel_dil) / stride + 1;
+    cmixnn_idx_t out_x_hi = (dim_im_in + left_padding < dim_kernel_dil) ? 0 : (dim_im_in + left_padding - dim_kernel_dil) / stride + 1;
+
+    out_y_lo = (out_y_lo > dim_im_out) ? dim_im_out : out_y_lo;
+    out_x_lo = (out_x_lo > dim_im_out) ? dim_im_out : out_x_lo;
+    out_y_hi = (out_y_hi > dim_im_out) ? dim_im_out : out_y_hi;
+    out_x_hi = (out_x_hi > dim_im_out) ? dim_im_out : out_x_hi;
+    out_y_hi = (out_y_hi < out_y_lo) ? out_y_lo : out_y_hi;
+    out_x_hi = (out_x_hi < out_x_lo) ? out_x_lo : out_x_hi;
+
+    /* interior part, computed with the whole kernel */
+    for (i_out_y = out_y_lo; i_out_y < out_y_hi; i_out_y++)
+    {
+        for (i_out_x = out_x_lo; i_out_x < out_x_hi; i_out_x++)
+        {
+            /* This part implements the im2col function */
+            if (ch_im_in % 16 == 0 && stride < dim_kernel && i_out_x > out_x_lo)
+            {
+                /*
+                 * the previous pixel of the row is still in bufferA and its kernel rows overlap the ones of this
+                 * pixel by dim_kernel - stride columns: copy them and convert only the stride new columns
+                 */
+                const int16_t *pPrev = ((pBuffer == bufferA) ? bufferA + numCol : pBuffer - numCol) + stride * ch_im_in;
+
+                for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+                {
+                    memcpy(pBuffer, pPrev, sizeof(int16_t) * (dim_kernel - stride) * ch_im_in);
+                    arm_s2_to_int16_reordered(
+                                                Im_in + (((i_ker_y * dim_im_in + i_out_x * stride - left_padding + dim_kernel - stride) * ch_im_in) >> 2),
+                                                pBuffer + (dim_kernel - stride) * ch_im_in,
+                                                ch_im_in * stride,
+                                                z_in);
+                    pBuffer += ch_im_in * dim_kernel;
+                    pPrev += ch_im_in * dim_kernel;
+                }
+            }
+            else if (ch_im_in % 16 == 0)
+            {
+                for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+                {
+                    arm_s2_to_int16_reordered(
+                                                Im_in + (((i_ker_y * dim_im_in + i_out_x * stride - left_padding) * ch_im_in) >> 2),
+                                                pBuffer,
+                                                ch_im_in * dim_kernel,
+                                                z_in);
+                    pBuffer += ch_im_in * dim_kernel;
+                }
+            }
+            else
+            {
+                /*
+                 * pixels do not fill whole vectors: gather the packed window and convert it at once, so that the
+                 * column is reordered in the same words as the weights
+                 */
+                arm_s2_to_int16_reordered(__im2col_gather(Im_in, dim_im_in, ch_im_in, ch_im_in, 2,
+                                                            i_out_y * stride - top_padding, i_out_x * stride - left_padding,
+                                                            dim_kernel, dim_kernel, 1, z_in, pBuffer, numCol),
+                                            pBuffer,
+                                            numCol,
+                                            z_in);
+                pBuffer += numCol;
+            }
+
+            if (pBuffer == bufferA + 2 * numCol)
+            {
+                /* the two pixels are not adjacent when the pair spans two rows */
+                const int32_t i_pix2 = i_out_y * dim_im_out + i_out_x;
+                pOut = Im_out + (((i_pix1) * ch_im_out) >> 2);
+                arm_nn_mat_mult_kernel_strided_reordered_s4_int16_s2(wt,
+                                                bufferA,
+                                                ch_im_out,
+                                                numCol,
+                                                bias,
+                                                pOut,
+                                                (i_pix2 - i_pix1) * ch_im_out,
+                                                z_out,
+                                                m_zero,
+                                                n_zero);
+                /* counter reset */
+                pBuffer = bufferA;
+            }
+            else
+            {
+                i_pix1 = i_out_y * dim_im_out + i_out_x;
+            }
+        }
+    }
+
+    /* check if there is left-over for compute */
+    if (pBuffer != bufferA)
+    {
+        /* single pixel left: duplicate its column and compute it twice in place */
+        memcpy(pBuffer, bufferA, sizeof(int16_t) * numCol);
+        pOut = Im_out + (((i_pix1) * ch_im_out) >> 2);
+        arm_nn_mat_mult_kernel_strided_reordered_s4_int16_s2(wt,
+                                                bufferA,
+                                                ch_im_out,
+                                                numCol,
+                                                bias,
+                                                pOut,
+                                                0,
+                                                z_out,
+                                                m_zero,
+                                                n_zero);
+        pBuffer = bufferA;
+    }
+
+    /*
+     *  Border part: top rows, left and right columns, bottom rows. The two pixels of a pair
+     *  only gather the kernel taps of the smallest window covering their receptive fields
+     *  inside the input, so the padded taps are mostly skipped instead of multiplied by zero.
+     *  Side columns are visited two rows at a time to pair pixels sharing the same window.
+     */
+    const cmixnn_idx_t n_side_rows = out_y_hi - out_y_lo;
+    const cmixnn_idx_t n_side_cols = out_x_lo + dim_im_out - out_x_hi;
+    const int32_t n_top = (out_y_lo - out_y_begin) * dim_im_out;
+    const int32_t n_sides = n_top + n_side_rows * n_side_cols;
+    const int32_t n_border = n_sides + (out_y_end - out_y_hi) * dim_im_out;
+
+    i_pix = 0;
+    while (i_pix < n_border)
+    {
+        const int32_t region_end = (i_pix < n_top) ? n_top : ((i_pix < n_sides) ? n_sides : n_border);
+        const int16_t n_pair = (i_pix + 1 < region_end) ? 2 : 1;
+        cmixnn_idx_t out_y[2], out_x[2];
+        cmixnn_idx_t ker_y0 = dim_kernel, ker_y1 = 0, ker_x0 = dim_kernel, ker_x1 = 0;
+        cmixnn_dim_t seg_len, seg_stride, numColW;
+        int16_t i_pair;
+
+        for (i_pair = 0; i_pair < n_pair; i_pair++)
+        {
+            const int32_t j = i_pix + i_pair;
+            cmixnn_idx_t k0, k1;
+
+            if (j < n_top)
+            {
+                out_y[i_pair] = out_y_begin + j / dim_im_out;
+                out_x[i_pair] = j % dim_im_out;
+            }
+            else if (j < n_sides)
+            {
+                const cmixnn_idx_t row = out_y_lo + (((j - n_top) / (2 * n_side_cols)) << 1);
+                const cmixnn_idx_t n_rows = (row + 1 < out_y_hi) ? 2 : 1;
+                const cmixnn_idx_t k = (j - n_top) % (2 * n_side_cols);
+
+                out_y[i_pair] = row + k % n_rows;
+                out_x[i_pair] = k / n_rows;
+                if (out_x[i_pair] >= out_x_lo)
+                {
+                    out_x[i_pair] += out_x_hi - out_x_lo;
+                }
+            }
+            else
+            {
+                out_y[i_pair] = out_y_hi + (j - n_sides) / dim_im_out;
+                out_x[i_pair] = (j - n_sides) % dim_im_out;
+            }
+
+            __kernel_window(out_y[i_pair] * stride - top_padding, dim_im_in, dim_kernel, dilation, &k0, &k1);
+            ker_y0 = (k0 < ker_y0) ? k0 : ker_y0;
+            ker_y1 = (k1 > ker_y1) ? k1 : ker_y1;
+            __kernel_window(out_x[i_pair] * stride - left_padding, dim_im_in, dim_kernel, dilation, &k0, &k1);
+            ker_x0 = (k0 < ker_x0) ? k0 : ker_x0;
+            ker_x1 = (k1 > ker_x1) ? k1 : ker_x1;
+        }
+
+        if (ch_im_in % 16 == 0)
+        {
+            /* kernel rows of the window start at 32-bit words of activations and weights */
+            seg_len = (ker_x1 - ker_x0) * ch_im_in;
+            seg_stride = dim_kernel * ch_im_in;
+        }
+        else
+        {
+            /* the window cannot be cut out of the weights: keep the whole kernel */
+            ker_y0 = 0;
+            ker_y1 = dim_kernel;
+            ker_x0 = 0;
+            ker_x1 = dim_kernel;
+            seg_len = numCol;
+            seg_stride = numCol;
+        }
+        numColW = (ker_y1 - ker_y0) * (ker_x1 - ker_x0) * ch_im_in;
+
+        /* This part implements the im2col function over the window */
+        for (i_pair = 0; i_pair < n_pair; i_pair++)
+        {
+            if (ch_im_in % 16 != 0)
+            {
+                /* whole kernel: gather the packed window, padded with z_in, and convert it at once */
+                arm_s2_to_int16_reordered(__im2col_gather(Im_in, dim_im_in, ch_im_in, ch_im_in, 2,
+                                                            out_y[i_pair] * stride - top_padding, out_x[i_pair] * stride - left_padding,
+                                                            dim_kernel, dim_kernel, dilation, z_in, pBuffer, numCol),
+                                            pBuffer,
+                                            numCol,
+                                            z_in);
+                pBuffer += numCol;
+                continue;
+            }
+            for (i_ker_y = ker_y0; i_ker_y < ker_y1; i_ker_y++)
+            {
+                const cmixnn_idx_t i_in_y = out_y[i_pair] * stride - top_padding + i_ker_y * dilation;
+                for (i_ker_x = ker_x0; i_ker_x < ker_x1; i_ker_x++)
+                {
+                    const cmixnn_idx_t i_in_x = out_x[i_pair] * stride - left_padding + i_ker_x * dilation;
+                    if (i_in_y < 0 || i_in_y >= dim_im_in || i_in_x < 0 || i_in_x >= dim_im_in)
+                    {
+                        memset(pBuffer, 0, sizeof(int16_t) * ch_im_in);
+                    }
+                    else
+                    {
+                        arm_s2_to_int16_reordered(
+                                                Im_in + (((i_in_y * dim_im_in + i_in_x) * ch_im_in) >> 2),
+                                                pBuffer,
+                                                ch_im_in,
+                                                z_in);
+                    }
+                    pBuffer += ch_im_in;
+                }
+            }
+        }
+
+        if (n_pair == 1)
+        {
+            /* single pixel: duplicate its column and compute it twice in place */
+            memcpy(pBuffer, bufferA, sizeof(int16_t) * numColW);
+        }
+
+        pOut = Im_out + (((out_y[0] * dim_im_out + out_x[0]) * ch_im_out) >> 2);
+        arm_nn_mat_mult_kernel_windowed_reordered_s4_int16_s2(
+                                                wt + (((ker_y0 * dim_kernel + ker_x0) * ch_im_in) >> 1),
+                                                bufferA,
+                                                ch_im_out,
+                                                numColW,
+                                                seg_len,
+                                                seg_stride,
+                                                numCol,
+                                                bias,
+                                                pOut,
+                                                (n_pair == 2) ? ((out_y[1] - out_y[0]) * dim_im_out + out_x[1] - out_x[0]) * ch_im_out : 0,
+                                                z_out,
+                                                m_zero,
+                                                n_zero);
+        /* counter reset */
+        pBuffer = bufferA;
+        i_pix += n_pair;
+    }
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXConv group
+ */
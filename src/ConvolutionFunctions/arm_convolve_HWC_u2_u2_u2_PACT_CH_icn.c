@@ -75,22 +75,36 @@
    * @param[in,out]   bufferB     pointer to buffer space for output
    * @return     The function returns either
    * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * ch_im_in must be a multiple of 4 and ch_im_out a multiple of 4, i.e., every pixel
+   * fills whole bytes. When ch_im_in is not a multiple of 16, the packed kernel window of an output pixel is
+   * gathered at the end of its bufferA column and converted at once, so that the column is reordered in the same
+   * 32-bit words as the filter rows of the weights.
+   *
+   * Output pixels whose receptive field overlaps the padding only multiply the kernel taps inside
+   * the input when ch_im_in is a multiple of 16, otherwise the whole kernel is used.
+   * right_padding and bottom_padding are implied by dim_im_out.
+   *
+   * When stride < dim_kernel and ch_im_in is a multiple of 16, consecutive interior pixels of a row
+   * reuse the dim_kernel - stride columns they share, so every input column is converted once per kernel row.
    */
 arm_status
 arm_convolve_HWC_u2_u2_u2_PACT_CH_icn(const uint8_t *Im_in,
-                    const uint16_t dim_im_in,
-                    const uint16_t ch_im_in,
+                    const cmixnn_dim_t dim_im_in,
+                    const cmixnn_dim_t ch_im_in,
                     const uint8_t *wt,
-                    const uint16_t ch_im_out,
-                    const uint16_t dim_kernel,
+                    const cmixnn_dim_t ch_im_out,
+                    const cmixnn_dim_t dim_kernel,
                     const uint8_t left_padding,
                     const uint8_t right_padding,
                     const uint8_t top_padding,
                     const uint8_t bottom_padding,
-                    const uint16_t stride,
+                    const cmixnn_dim_t stride,
                     const int32_t *bias,
                     uint8_t *Im_out,
-                    const uint16_t dim_im_out,
+                    const cmixnn_dim_t dim_im_out,
                     const uint8_t z_in,
                     const uint8_t *z_wt,
                     const uint8_t z_out,
@@ -103,103 +117,110 @@ arm_convolve_HWC_u2_u2_u2_PACT_CH_icn(const uint8_t *Im_in,
 #if defined(ARM_MATH_DSP)
     /* Run the following code for Cortex-M4 and Cortex-M7 */
 
-    int16_t i_out_y, i_out_x, i_ker_y, i_ker_x;
+    cmixnn_idx_t i_out_y, i_out_x, i_ker_y, i_ker_x;
     int16_t *pBuffer = bufferA;
     uint8_t *pOut = Im_out;
+    /* spatial extent of the kernel and distance between its taps */
+    const cmixnn_idx_t dim_kernel_dil = dim_kernel;
+    const cmixnn_idx_t dilation = 1;
+    const cmixnn_dim_t numCol = ch_im_in * dim_kernel * dim_kernel;
+    int32_t i_pix, i_pix1 = 0;
 
-    if (ch_im_in % 16 != 0 || ch_im_out % 16 != 0)
+    if (ch_im_in % 4 != 0 || ch_im_out % 4 != 0)
     {
         /* check if the input dimension meets the constraints */
         return ARM_MATH_SIZE_MISMATCH;
     }
 
+    /* rows of the output computed by this call */
+    const cmixnn_idx_t out_y_begin = 0;
+    const cmixnn_idx_t out_y_end = dim_im_out;
+
     /*
-     *  Here we split the entire matrix into three regions depending on the padding situation
-     *    Top: i_out_y from 0 to padding - 1
-     * Middle: i_out_y from padding to dim_im_out-padding-1
-     * Bottom: i_out_y from dim_im_out-padding to dim_im_out-1
+     *  Here we split the output into the interior, whose receptive field lies inside the input,
+     *  and the border, whose receptive field overlaps the padding:
+     *    Top: i_out_y from out_y_begin to out_y_lo - 1
+     *   Left: i_out_x from 0 to out_x_lo - 1
+     *  Right: i_out_x from out_x_hi to dim_im_out - 1
+     * Bottom: i_out_y from out_y_hi to out_y_end - 1
      */
-
-    /* top part */
-    for (i_out_y = 0; i_out_y < top_padding; i_out_y++)
+    cmixnn_idx_t out_y_lo = (top_padding + stride - 1) / stride;
+    cmixnn_idx_t out_x_lo = (left_padding + stride - 1) / stride;
+    cmixnn_idx_t out_y_hi = (dim_im_in + top_padding < dim_kernel_dil) ? 0 : (dim_im_in + top_padding - dim_kernel_dil) / stride + 1;
+    cmixnn_idx_t out_x_hi = (dim_im_in + left_padding < dim_kernel_dil) ? 0 : (dim_im_in + left_padding - dim_kernel_dil) / stride + 1;
+
+    out_y_lo = (out_y_lo > dim_im_out) ? dim_im_out : out_y_lo;
+    out_x_lo = (out_x_lo > dim_im_out) ? dim_im_out : out_x_lo;
+    out_y_hi = (out_y_hi > dim_im_out) ? dim_im_out : out_y_hi;
+    out_x_hi = (out_x_hi > dim_im_out) ? dim_im_out : out_x_hi;
+    out_y_hi = (out_y_hi < out_y_lo) ? out_y_lo : out_y_hi;
+    out_x_hi = (out_x_hi < out_x_lo) ? out_x_lo : out_x_hi;
+
+    /* interior part, computed with the whole kernel */
+    for (i_out_y = out_y_lo; i_out_y < out_y_hi; i_out_y++)
     {
-        for (i_out_x = 0; i_out_x < dim_im_out; i_out_x++)
+        for (i_out_x = out_x_lo; i_out_x < out_x_hi; i_out_x++)
         {
             /* This part implements the im2col function */
-            for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+            if (ch_im_in % 16 == 0 && stride < dim_kernel && i_out_x > out_x_lo)
             {
-                for (i_ker_x = i_out_x * stride - left_padding; i_ker_x < i_out_x * stride - left_padding + dim_kernel; i_ker_x++)
+                /*
+                 * the previous pixel of the row is still in bufferA and its kernel rows overlap the ones of this
+                 * pixel by dim_kernel - stride columns: copy them and convert only the stride new columns
+                 */
+                const int16_t *pPrev = ((pBuffer == bufferA) ? bufferA + numCol : pBuffer - numCol) + stride * ch_im_in;
+
+                for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
                 {
-                    if (i_ker_y < 0 || i_ker_y >= dim_im_in || i_ker_x < 0 || i_ker_x >= dim_im_in)
-                    {
-                        memset(pBuffer, 0, sizeof(int16_t) * ch_im_in);
-                    }
-                    else
-                    {
-                        arm_u2_to_int16_reordered(
-                                                Im_in + (((i_ker_y * dim_im_in + i_ker_x) * ch_im_in) >> 2),
-                                                pBuffer,
-                                                ch_im_in,
+                    memcpy(pBuffer, pPrev, sizeof(int16_t) * (dim_kernel - stride) * ch_im_in);
+                    arm_u2_to_int16_reordered(
+                                                Im_in + (((i_ker_y * dim_im_in + i_out_x * stride - left_padding + dim_kernel - stride) * ch_im_in) >> 2),
+                                                pBuffer + (dim_kernel - stride) * ch_im_in,
+                                                ch_im_in * stride,
                                                 z_in);
-                    }
-                    pBuffer += ch_im_in;
+                    pBuffer += ch_im_in * dim_kernel;
+                    pPrev += ch_im_in * dim_kernel;
                 }
             }
-
-            if (pBuffer == bufferA + 2 * ch_im_in * dim_kernel * dim_kernel)
-            {
-                pOut = arm_nn_mat_mult_kernel_reordered_u2_int16_u2_PACT_CH_icn(wt,
-                                                bufferA,
-                                                ch_im_out,
-                                                ch_im_in * dim_kernel * dim_kernel,
-                                                bias,
-                                                pOut,
-                                                z_wt,
-                                                z_out,
-                                                m_zero,
-                                                n_zero);
-                /* counter reset */
-                pBuffer = bufferA;
-            }
-        }
-    }
-
-    /* middle part, here we also divide the x into left, mid and right */
-    for (; i_out_y < dim_im_out - bottom_padding; i_out_y++)
-    {
-
-        /* left part */
-        for (i_out_x = 0; i_out_x < left_padding; i_out_x++)
-        {
-            /* This part implements the im2col function */
-            for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+            else if (ch_im_in % 16 == 0)
             {
-                for (i_ker_x = i_out_x * stride - left_padding; i_ker_x < i_out_x * stride - left_padding + dim_kernel; i_ker_x++)
+                for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
                 {
-                    if (i_ker_x < 0 || i_ker_x >= dim_im_in)
-                    {
-                        memset(pBuffer, 0, sizeof(int16_t) * ch_im_in);
-                    }
-                    else
-                    {
-                        arm_u2_to_int16_reordered(
-                                                Im_in + (((i_ker_y * dim_im_in + i_ker_x) * ch_im_in) >> 2),
+                    arm_u2_to_int16_reordered(
+                                                Im_in + (((i_ker_y * dim_im_in + i_out_x * stride - left_padding) * ch_im_in) >> 2),
                                                 pBuffer,
-                                                ch_im_in,
+                                                ch_im_in * dim_kernel,
                                                 z_in);
-                    }
-                    pBuffer += ch_im_in;
+                    pBuffer += ch_im_in * dim_kernel;
                 }
             }
+            else
+            {
+                /*
+                 * pixels do not fill whole vectors: gather the packed window and convert it at once, so that the
+                 * column is reordered in the same words as the weights
+                 */
+                arm_u2_to_int16_reordered(__im2col_gather(Im_in, dim_im_in, ch_im_in, ch_im_in, 2,
+                                                            i_out_y * stride - top_padding, i_out_x * stride - left_padding,
+                                                            dim_kernel, dim_kernel, 1, z_in, pBuffer, numCol),
+                                            pBuffer,
+                                            numCol,
+                                            z_in);
+                pBuffer += numCol;
+            }
 
-            if (pBuffer == bufferA + 2 * ch_im_in * dim_kernel * dim_kernel)
+            if (pBuffer == bufferA + 2 * numCol)
             {
-                pOut = arm_nn_mat_mult_kernel_reordered_u2_int16_u2_PACT_CH_icn(wt,
+                /* the two pixels are not adjacent when the pair spans two rows */
+                const int32_t i_pix2 = i_out_y * dim_im_out + i_out_x;
+                pOut = Im_out + (((i_pix1) * ch_im_out) >> 2);
+                arm_nn_mat_mult_kernel_strided_reordered_u2_int16_u2_PACT_CH_icn(wt,
                                                 bufferA,
                                                 ch_im_out,
-                                                ch_im_in * dim_kernel * dim_kernel,
+                                                numCol,
                                                 bias,
                                                 pOut,
+                                                (i_pix2 - i_pix1) * ch_im_out,
                                                 z_wt,
                                                 z_out,
                                                 m_zero,
@@ -207,98 +228,139 @@ arm_convolve_HWC_u2_u2_u2_PACT_CH_icn(const uint8_t *Im_in,
                 /* counter reset */
                 pBuffer = bufferA;
             }
-        }
-
-        /* mid part */
-        for (; i_out_x < dim_im_out - right_padding; i_out_x++)
-        {
-            /* This part implements the im2col function */
-            for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+            else
             {
-                arm_u2_to_int16_reordered(
-                                                Im_in + (((i_ker_y * dim_im_in + i_out_x * stride - top_padding) * ch_im_in) >> 2),
-                                                pBuffer,
-                                                ch_im_in * dim_kernel,
-                                                z_in);
-                pBuffer += ch_im_in * dim_kernel;
+                i_pix1 = i_out_y * dim_im_out + i_out_x;
             }
+        }
+    }
 
-            if (pBuffer == bufferA + 2 * ch_im_in * dim_kernel * dim_kernel)
-            {
-                pOut = arm_nn_mat_mult_kernel_reordered_u2_int16_u2_PACT_CH_icn(wt,
+    /* check if there is left-over for compute */
+    if (pBuffer != bufferA)
+    {
+        /* single pixel left: duplicate its column and compute it twice in place */
+        memcpy(pBuffer, bufferA, sizeof(int16_t) * numCol);
+        pOut = Im_out + (((i_pix1) * ch_im_out) >> 2);
+        arm_nn_mat_mult_kernel_strided_reordered_u2_int16_u2_PACT_CH_icn(wt,
                                                 bufferA,
                                                 ch_im_out,
-                                                ch_im_in * dim_kernel * dim_kernel,
+                                                numCol,
                                                 bias,
                                                 pOut,
+                                                0,
                                                 z_wt,
                                                 z_out,
                                                 m_zero,
                                                 n_zero);
-                /* counter reset */
-                pBuffer = bufferA;
-            }
-        }
+        pBuffer = bufferA;
+    }
 
-        /* right part */
-        for (; i_out_x < dim_im_out; i_out_x++)
+    /*
+     *  Border part: top rows, left and right columns, bottom rows. The two pixels of a pair
+     *  only gather the kernel taps of the smallest window covering their receptive fields
+     *  inside the input, so the padded taps are mostly skipped instead of multiplied by zero.
+     *  Side columns are visited two rows at a time to pair pixels sharing the same window.
+     */
+    const cmixnn_idx_t n_side_rows = out_y_hi - out_y_lo;
+    const cmixnn_idx_t n_side_cols = out_x_lo + dim_im_out - out_x_hi;
+    const int32_t n_top = (out_y_lo - out_y_begin) * dim_im_out;
+    const int32_t n_sides = n_top + n_side_rows * n_side_cols;
+    const int32_t n_border = n_sides + (out_y_end - out_y_hi) * dim_im_out;
+
+    i_pix = 0;
+    while (i_pix < n_border)
+    {
+        const int32_t region_end = (i_pix < n_top) ? n_top : ((i_pix < n_sides) ? n_sides : n_border);
+        const int16_t n_pair = (i_pix + 1 < region_end) ? 2 : 1;
+        cmixnn_idx_t out_y[2], out_x[2];
+        cmixnn_idx_t ker_y0 = dim_kernel, ker_y1 = 0, ker_x0 = dim_kernel, ker_x1 = 0;
+        cmixnn_dim_t seg_len, seg_stride, numColW;
+        int16_t i_pair;
+
+        for (i_pair = 0; i_pair < n_pair; i_pair++)
         {
-            /* This part implements the im2col function */
-            for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+            const int32_t j = i_pix + i_pair;
+            cmixnn_idx_t k0, k1;
+
+            if (j < n_top)
             {
-                for (i_ker_x = i_out_x * stride - left_padding; i_ker_x < i_out_x * stride - left_padding + dim_kernel; i_ker_x++)
+                out_y[i_pair] = out_y_begin + j / dim_im_out;
+                out_x[i_pair] = j % dim_im_out;
+            }
+            else if (j < n_sides)
+            {
+                const cmixnn_idx_t row = out_y_lo + (((j - n_top) / (2 * n_side_cols)) << 1);
+                const cmixnn_idx_t n_rows = (row + 1 < out_y_hi) ? 2 : 1;
+                const cmixnn_idx_t k = (j - n_top) % (2 * n_side_cols);
+
+                out_y[i_pair] = row + k % n_rows;
+                out_x[i_pair] = k / n_rows;
+                if (out_x[i_pair] >= out_x_lo)
                 {
-                    if (i_ker_x < 0 || i_ker_x >= dim_im_in)
-                    {
-                        memset(pBuffer, 0, sizeof(int16_t) * ch_im_in);
-                    }
-                    else
-                    {
-                        arm_u2_to_int16_reordered(
-                                                Im_in + (((i_ker_y * dim_im_in + i_ker_x) * ch_im_in) >> 2),
-                                                pBuffer,
-                                                ch_im_in,
-                                                z_in);
-                    }
-                    pBuffer += ch_im_in;
+                    out_x[i_pair] += out_x_hi - out_x_lo;
                 }
             }
-
-            if (pBuffer == bufferA + 2 * ch_im_in * dim_kernel * dim_kernel)
+            else
             {
-                pOut = arm_nn_mat_mult_kernel_reordered_u2_int16_u2_PACT_CH_icn(wt,
-                                                bufferA,
-                                                ch_im_out,
-                                                ch_im_in * dim_kernel * dim_kernel,
-                                                bias,
-                                                pOut,
-                                                z_wt,
-                                                z_out,
-                                                m_zero,
-                                                n_zero);
-                /* counter reset */
-                pBuffer = bufferA;
+                out_y[i_pair] = out_y_hi + (j - n_sides) / dim_im_out;
+                out_x[i_pair] = (j - n_sides) % dim_im_out;
             }
+
+            __kernel_window(out_y[i_pair] * stride - top_padding, dim_im_in, dim_kernel, dilation, &k0, &k1);
+            ker_y0 = (k0 < ker_y0) ? k0 : ker_y0;
+            ker_y1 = (k1 > ker_y1) ? k1 : ker_y1;
+            __kernel_window(out_x[i_pair] * stride - left_padding, dim_im_in, dim_kernel, dilation, &k0, &k1);
+            ker_x0 = (k0 < ker_x0) ? k0 : ker_x0;
+            ker_x1 = (k1 > ker_x1) ? k1 : ker_x1;
         }
-    }
 
-    for (; i_out_y < dim_im_out; i_out_y++)
-    {
-        for (i_out_x = 0; i_out_x < dim_im_out; i_out_x++)
+        if (ch_im_in % 16 == 0)
         {
-            /* This part implements the im2col function */
-            for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+            /* kernel rows of the window start at 32-bit words of activations and weights */
+            seg_len = (ker_x1 - ker_x0) * ch_im_in;
+            seg_stride = dim_kernel * ch_im_in;
+        }
+        else
+        {
+            /* the window cannot be cut out of the weights: keep the whole kernel */
+            ker_y0 = 0;
+            ker_y1 = dim_kernel;
+            ker_x0 = 0;
+            ker_x1 = dim_kernel;
+            seg_len = numCol;
+            seg_stride = numCol;
+        }
+        numColW = (ker_y1 - ker_y0) * (ker_x1 - ker_x0) * ch_im_in;
+
+        /* This part implements the im2col function over the window */
+        for (i_pair = 0; i_pair < n_pair; i_pair++)
+        {
+            if (ch_im_in % 16 != 0)
+            {
+                /* whole kernel: gather the packed window, padded with z_in, and convert it at once */
+                arm_u2_to_int16_reordered(__im2col_gather(Im_in, dim_im_in, ch_im_in, ch_im_in, 2,
+                                                            out_y[i_pair] * stride - top_padding, out_x[i_pair] * stride - left_padding,
+                                                            dim_kernel, dim_kernel, dilation, z_in, pBuffer, numCol),
+                                            pBuffer,
+                                            numCol,
+                                            z_in);
+                pBuffer += numCol;
+                continue;
+            }
+            for (i_ker_y = ker_y0; i_ker_y < ker_y1; i_ker_y++)
             {
-                for (i_ker_x = i_out_x * stride - left_padding; i_ker_x < i_out_x * stride - left_padding + dim_kernel; i_ker_x++)
+                const cmixnn_idx_t i_in_y = out_y[i_pair] * stride - top_padding + i_ker_y * dilation;
+                for (i_ker_x = ker_x0; i_ker_x < ker_x1; i_ker_x++)
                 {
-                    if (i_ker_y < 0 || i_ker_y >= dim_im_in || i_ker_x < 0 || i_ker_x >= dim_im_in)
+                    const cmixnn_idx_t i_in_x = out_x[i_pair] * stride - left_padding + i_ker_x * dilation;
+                    if (i_in_y < 0 || i_in_y >= dim_im_in || i_in_x < 0 || i_in_x >= dim_im_in)
                     {
                         memset(pBuffer, 0, sizeof(int16_t) * ch_im_in);
                     }
                     else
                     {
                         arm_u2_to_int16_reordered(
-                                                Im_in + (((i_ker_y * dim_im_in + i_ker_x) * ch_im_in) >> 2),
+                                                Im_in + (((i_in_y * dim_im_in + i_in_x) * ch_im_in) >> 2),
                                                 pBuffer,
                                                 ch_im_in,
                                                 z_in);
@@ -306,140 +368,33 @@ arm_convolve_HWC_u2_u2_u2_PACT_CH_icn(const uint8_t *Im_in,
                     pBuffer += ch_im_in;
                 }
             }
+        }
 
-            if (pBuffer == bufferA + 2 * ch_im_in * dim_kernel * dim_kernel)
-            {
-                pOut = arm_nn_mat_mult_kernel_reordered_u2_int16_u2_PACT_CH_icn(wt,
+        if (n_pair == 1)
+        {
+            /* single pixel: duplicate its column and compute it twice in place */
+            memcpy(pBuffer, bufferA, sizeof(int16_t) * numColW);
+        }
+
+        pOut = Im_out + (((out_y[0] * dim_im_out + out_x[0]) * ch_im_out) >> 2);
+        arm_nn_mat_mult_kernel_windowed_reordered_u2_int16_u2_PACT_CH_icn(
+                                                wt + (((ker_y0 * dim_kernel + ker_x0) * ch_im_in) >> 2),
                                                 bufferA,
                                                 ch_im_out,
-                                                ch_im_in * dim_kernel * dim_kernel,
+                                                numColW,
+                                                seg_len,
+                                                seg_stride,
+                                                numCol,
                                                 bias,
                                                 pOut,
+                                                (n_pair == 2) ? ((out_y[1] - out_y[0]) * dim_im_out + out_x[1] - out_x[0]) * ch_im_out : 0,
                                                 z_wt,
                                                 z_out,
                                                 m_zero,
                                                 n_zero);
-                /* counter reset */
-                pBuffer = bufferA;
-            }
-        }
-    }
-
-    /* check if there is left-over for compute */
-    if (pBuffer != bufferA)
-    {
-        /* Negative N_ZERO Normalization */
-        int8_t n_zero1;
-        int8_t n_zero2;
-
-
-        /* Weights Pointer */
-        const uint8_t *pA = wt;
-        int       i;
-
-        int pOut_per_byte = 4;
-
-        for (i = 0; i < ch_im_out; i++)
-        {
-            /* Offset over Weights */
-            int16_t VzA[2] = {z_wt[i], z_wt[i]};
-            const int16_t *pzA = VzA;
-            int32_t inzA = *__SIMD32(pzA);
-            int32_t sum = bias[i];
-            int16_t *pB = bufferA;
-
-            uint16_t  colCnt = ch_im_in * dim_kernel * dim_kernel >> 4; // config.wt_data_t: u2 (16x uint2_t)
-
-            /* accumulate over the vector */
-            while (colCnt)
-            {
-                int32_t inA1, inA2;
-                int32_t inA3, inA4;
-                int32_t inA5, inA6;
-                int32_t inA7, inA8;
-                int32_t inB1, inB2;
-
-                pA = (uint8_t *) read_and_pad_reordered_u2((void *)pA, &inA1, &inA2, &inA3, &inA4, &inA5, &inA6, &inA7, &inA8);
-
-                inB1 = *__SIMD32(pB)++;
-                inA1 = __SSUB16(inA1, inzA);
-                inA2 = __SSUB16(inA2, inzA);
-                sum = __SMLAD(inA1, inB1, sum);
-                inB2 = *__SIMD32(pB)++;
-                sum = __SMLAD(inA2, inB2, sum);
-                inB1 = *__SIMD32(pB)++;
-                inA3 = __SSUB16(inA3, inzA);
-                inA4 = __SSUB16(inA4, inzA);
-                sum = __SMLAD(inA3, inB1, sum);
-                inB2 = *__SIMD32(pB)++;
-                sum = __SMLAD(inA4, inB2, sum);
-                inB1 = *__SIMD32(pB)++;
-                inA5 = __SSUB16(inA5, inzA);
-                inA6 = __SSUB16(inA6, inzA);
-                sum = __SMLAD(inA5, inB1, sum);
-                inB2 = *__SIMD32(pB)++;
-                sum = __SMLAD(inA6, inB2, sum);
-                inB1 = *__SIMD32(pB)++;
-                inA7 = __SSUB16(inA7, inzA);
-                inA8 = __SSUB16(inA8, inzA);
-                sum = __SMLAD(inA7, inB1, sum);
-                inB2 = *__SIMD32(pB)++;
-                sum = __SMLAD(inA8, inB2, sum);
-                colCnt--;
-            }
-
-            colCnt = ch_im_in * dim_kernel * dim_kernel & 0xf; // config.wt_data_t: u2 (16x uint2_t)
-
-            int wt_per_byte = 4;
-            while (colCnt)
-            {
-                uint8_t inB1 = (uint8_t) *pB++;
-                uint8_t inA1;
-                switch(wt_per_byte)
-                {
-                    case 4:
-                        inA1 = (uint8_t) __USAT(*pA, 2);
-                        break;
-                    case 3:
-                        inA1 = (uint8_t) __USAT(__ROR(*pA, 2), 2);
-                        break;
-                    case 2:
-                        inA1 = (uint8_t) __USAT(__ROR(*pA, 2), 4);
-                        break;
-                    case 1:
-                        inA1 = (uint8_t) __USAT(__ROR(*pA, 2), 6);
-                        pA++;
-                        break;
-                }
-                inA1 -= z_wt[i];
-                sum += inA1 * inB1;
-                colCnt--;
-            }
-
-            /* Normalize by ICN (u2 output) */
-            __n_zero_negative_normalization(n_zero[i],&n_zero1,&n_zero2);
-            sum  = ((__HI_SMULL(sum << n_zero1 ,m_zero[i])) >> n_zero2) + z_out;
-
-            /* Store Outputs (u2 output) */
-            switch(pOut_per_byte){
-                case 4:
-                    *pOut  = ( __USAT(sum, 2) );
-                    pOut_per_byte--;
-                    break;
-                case 3:
-                    *pOut |= ( __USAT(sum, 2) << 2);
-                    pOut_per_byte--;
-                    break;
-                case 2:
-                    *pOut |= ( __USAT(sum, 2) << 4);
-                    pOut_per_byte--;
-                    break;
-                case 1:
-                    *pOut++ |= ( __USAT(sum, 2) << 6);
-                    pOut_per_byte-=4;
-                    break;
-            }
-        }
+        /* counter reset */
+        pBuffer = bufferA;
+        i_pix += n_pair;
     }
 
 #else
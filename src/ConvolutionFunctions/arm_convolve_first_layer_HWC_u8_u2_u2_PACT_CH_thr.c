@@ -0,0 +1,212 @@
+/* Copyright (C) 2020 University of Bologna
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+ /******************************************************************
+ * Project:      CMixNN Inference Library
+ * Title:        arm_convolve_first_layer_HWC_u8_u2_u2_PACT_CH_thr.c
+ * Description:  Mixed Precision Convolutional function for the first layer that uses u8
+ *               activations, u2 weights and produce u2
+ *               output activations. Outputs are quantized using thr
+ *               folding technique.
+ * Target:       ARM Cortex-M cores
+ *
+ * Date:         10 February 2020
+ * Revision:     Release v1.0.0
+ *
+ * Authors:      Alessandro Capotondi
+ *                 <alessandro.capotondi AT unibo.it>
+ *               Marco Fariselli
+ *                 <marco.fariselli AT greenwaves-technologies.com>
+ *               Manuele Rusci 
+ *                 <manuele.rusci AT unibo.it>
+ *
+ ******************************************************************/
+
+#include <assert.h>
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXConv
+ * @{
+ */
+
+  /**
+   * @brief Mixed Precision First Layer Convolution thr (in: u8, out: u2, wt: u2)
+   *
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimension
+   * @param[in]       ch_im_in    number of input tensor channels, from 1 to 3
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       left_pad    padding sizes
+   * @param[in]       right_pad   padding sizes
+   * @param[in]       top_pad     padding sizes
+   * @param[in]       bottom_pad  padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       z_in        input offset
+   * @param[in]       *z_wt       weights offset, per-output channel
+   * @param[in]       thresholds  pointer to thresholds
+   * @param[in,out]   bufferA     pointer to buffer space for input, 2*ch_im_in*dim_kernel*dim_kernel int16_t
+   * @param[in,out]   bufferB     pointer to buffer space for one padded kernel row, dim_kernel*ch_im_in uint8_t
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * With few input channels a pixel does not fill a SIMD vector, so the im2col converts each
+   * kernel row (dim_kernel*ch_im_in contiguous values) at once. Rows crossing the left or right
+   * border are first gathered in bufferB, where the padded pixels are set to z_in.
+   *
+   * Each filter row holds the dim_kernel kernel rows one after the other; the values of every
+   * kernel row are reordered as a single vector of dim_kernel*ch_im_in elements.
+   */
+arm_status
+arm_convolve_first_layer_HWC_u8_u2_u2_PACT_CH_thr(const uint8_t *Im_in,
+                    const cmixnn_dim_t dim_im_in,
+                    const cmixnn_dim_t ch_im_in,
+                    const uint8_t *wt,
+                    const cmixnn_dim_t ch_im_out,
+                    const cmixnn_dim_t dim_kernel,
+                    const uint8_t left_padding,
+                    const uint8_t right_padding,
+                    const uint8_t top_padding,
+                    const uint8_t bottom_padding,
+                    const cmixnn_dim_t stride,
+                    const int32_t *bias,
+                    uint8_t *Im_out,
+                    const cmixnn_dim_t dim_im_out,
+                    const uint8_t z_in,
+                    const uint8_t *z_wt,
+                    const int16_t *thresholds,
+                    int16_t * bufferA,
+                    uint8_t *bufferB)
+{
+
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    cmixnn_idx_t i_out_y, i_out_x, i_ker_y, i_ker_x, i_ch;
+    int16_t *pBuffer = bufferA;
+    uint8_t *pOut = Im_out;
+    const cmixnn_dim_t ker_row = ch_im_in * dim_kernel;
+    const cmixnn_dim_t numCol = ker_row * dim_kernel;
+
+    if (ch_im_in == 0 || ch_im_in > 3 || ch_im_out % 4 != 0)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    for (i_out_y = 0; i_out_y < dim_im_out; i_out_y++)
+    {
+        for (i_out_x = 0; i_out_x < dim_im_out; i_out_x++)
+        {
+            const cmixnn_idx_t i_in_x = i_out_x * stride - left_padding;
+
+            /* This part implements the im2col function, one kernel row at a time */
+            for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+            {
+                if (i_ker_y < 0 || i_ker_y >= dim_im_in)
+                {
+                    memset(pBuffer, 0, sizeof(int16_t) * ker_row);
+                }
+                else if (i_in_x >= 0 && i_in_x + dim_kernel <= dim_im_in)
+                {
+                    arm_u8_to_int16_reordered(Im_in + (i_ker_y * dim_im_in + i_in_x) * ch_im_in,
+                                                pBuffer,
+                                                ker_row,
+                                                z_in);
+                }
+                else
+                {
+                    /* border row: pad with z_in, that is zero once the offset is removed */
+                    uint8_t *pRow = bufferB;
+                    for (i_ker_x = i_in_x; i_ker_x < i_in_x + dim_kernel; i_ker_x++)
+                    {
+                        for (i_ch = 0; i_ch < ch_im_in; i_ch++)
+                        {
+                            if (i_ker_x < 0 || i_ker_x >= dim_im_in)
+                            {
+                                *pRow++ = z_in;
+                            }
+                            else
+                            {
+                                *pRow++ = Im_in[(i_ker_y * dim_im_in + i_ker_x) * ch_im_in + i_ch];
+                            }
+                        }
+                    }
+                    arm_u8_to_int16_reordered(bufferB,
+                                                pBuffer,
+                                                ker_row,
+                                                z_in);
+                }
+                pBuffer += ker_row;
+            }
+
+            if (pBuffer == bufferA + 2 * numCol)
+            {
+                pOut = arm_nn_mat_mult_kernel_reordered_u2_int16_u2_PACT_CH_thr(wt,
+                                                bufferA,
+                                                ch_im_out,
+                                                numCol,
+                                                bias,
+                                                pOut,
+                                                z_wt,
+                                                thresholds);
+                /* counter reset */
+                pBuffer = bufferA;
+            }
+        }
+    }
+
+    /* check if there is left-over for compute */
+    if (pBuffer != bufferA)
+    {
+        /* single pixel left: duplicate its column and compute it twice in place */
+        memcpy(pBuffer, bufferA, sizeof(int16_t) * numCol);
+        arm_nn_mat_mult_kernel_strided_reordered_u2_int16_u2_PACT_CH_thr(wt,
+                                                bufferA,
+                                                ch_im_out,
+                                                numCol,
+                                                bias,
+                                                pOut,
+                                                0,
+                                                z_wt,
+                                                thresholds);
+    }
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXConv group
+ */
\ No newline at end of file
@@ -0,0 +1,227 @@
+/* Copyright (C) 2020 University of Bologna
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+ /******************************************************************
+ * Project:      CMixNN Inference Library
+ * Title:        arm_convolve_grouped_HWC_u2_u2_u2_PACT_CH_thr.c
+ * Description:  Mixed Precision Grouped Convolutional function that uses u2
+ *               activations, u2 weights and produce u2
+ *               output activations. Outputs are quantized using thr
+ *               folding technique.
+ * Target:       ARM Cortex-M cores
+ *
+ * Date:         10 February 2020
+ * Revision:     Release v1.0.0
+ *
+ * Authors:      Alessandro Capotondi
+ *                 <alessandro.capotondi AT unibo.it>
+ *               Marco Fariselli
+ *                 <marco.fariselli AT greenwaves-technologies.com>
+ *               Manuele Rusci 
+ *                 <manuele.rusci AT unibo.it>
+ *
+ ******************************************************************/
+
+#include <assert.h>
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXConv
+ * @{
+ */
+
+  /**
+   * @brief Mixed Precision Grouped Convolution thr (in: u2, out: u2, wt: u2)
+   *
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimension
+   * @param[in]       ch_im_in    number of input tensor channels (all groups)
+   * @param[in]       wt          pointer to kernel weights, stored group by group
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels (all groups)
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       left_pad    padding sizes
+   * @param[in]       right_pad   padding sizes
+   * @param[in]       top_pad     padding sizes
+   * @param[in]       bottom_pad  padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       groups      number of groups, each one convolving ch_im_in/groups input channels
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       z_in        input offset
+   * @param[in]       *z_wt       weights offset, per-output channel
+   * @param[in]       thresholds  pointer to thresholds
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * Group g reads the input channels [g*ch_im_in/groups, (g+1)*ch_im_in/groups) directly from
+   * the packed HWC input and writes its ch_im_out/groups output channels at the matching
+   * channel offset of the packed HWC output, so no channel gathering or scattering is needed.
+   */
+arm_status
+arm_convolve_grouped_HWC_u2_u2_u2_PACT_CH_thr(const uint8_t *Im_in,
+                    const cmixnn_dim_t dim_im_in,
+                    const cmixnn_dim_t ch_im_in,
+                    const uint8_t *wt,
+                    const cmixnn_dim_t ch_im_out,
+                    const cmixnn_dim_t dim_kernel,
+                    const uint8_t left_padding,
+                    const uint8_t right_padding,
+                    const uint8_t top_padding,
+                    const uint8_t bottom_padding,
+                    const cmixnn_dim_t stride,
+                    const cmixnn_dim_t groups,
+                    const int32_t *bias,
+                    uint8_t *Im_out,
+                    const cmixnn_dim_t dim_im_out,
+                    const uint8_t z_in,
+                    const uint8_t *z_wt,
+                    const int16_t *thresholds,
+                    int16_t * bufferA,
+                    uint8_t *bufferB)
+{
+
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    cmixnn_idx_t i_out_y, i_out_x, i_ker_y, i_ker_x;
+    int16_t *pBuffer = bufferA;
+    uint8_t *pOut = Im_out;
+    cmixnn_dim_t g;
+
+    if (groups == 0 || ch_im_in % groups != 0 || ch_im_out % groups != 0)
+    {
+        /* check if the channels can be split in groups */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    /* per-group input channels, output channels and matrix columns */
+    const cmixnn_dim_t ch_in_g = ch_im_in / groups;
+    const cmixnn_dim_t ch_out_g = ch_im_out / groups;
+    const cmixnn_dim_t numCol = ch_in_g * dim_kernel * dim_kernel;
+
+    if (ch_in_g % 4 != 0 || ch_out_g % 4 != 0)
+    {
+        /* check if the group dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    for (g = 0; g < groups; g++)
+    {
+        /* channel slices of the input/output tensors and parameters of this group */
+        const uint8_t *Im_in_g = Im_in + ((g * ch_in_g) >> 2);
+        const uint8_t *wt_g = wt + g * ch_out_g * ((numCol + 3) >> 2);
+        const int32_t *bias_g = bias + g * ch_out_g;
+        const uint8_t *z_wt_g = z_wt + g * ch_out_g;
+        const int16_t *thresholds_g = thresholds + ((g * ch_out_g) << 2);
+        pOut = Im_out + ((g * ch_out_g) >> 2);
+        pBuffer = bufferA;
+
+        for (i_out_y = 0; i_out_y < dim_im_out; i_out_y++)
+        {
+            for (i_out_x = 0; i_out_x < dim_im_out; i_out_x++)
+            {
+                if (ch_in_g % 16 != 0)
+                {
+                    /* pixels do not fill whole vectors: gather the packed window, padded with z_in, and convert it at once */
+                    arm_u2_to_int16_reordered(__im2col_gather(Im_in_g, dim_im_in, ch_im_in, ch_in_g, 2,
+                                                                i_out_y * stride - top_padding, i_out_x * stride - left_padding,
+                                                                dim_kernel, dim_kernel, 1, z_in, pBuffer, numCol),
+                                                pBuffer,
+                                                numCol,
+                                                z_in);
+                    pBuffer += numCol;
+                }
+                else
+                {
+                    /* This part implements the im2col function over the channel slice of the group */
+                    for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+                    {
+                        for (i_ker_x = i_out_x * stride - left_padding; i_ker_x < i_out_x * stride - left_padding + dim_kernel; i_ker_x++)
+                        {
+                            if (i_ker_y < 0 || i_ker_y >= dim_im_in || i_ker_x < 0 || i_ker_x >= dim_im_in)
+                            {
+                                memset(pBuffer, 0, sizeof(int16_t) * ch_in_g);
+                            }
+                            else
+                            {
+                                arm_u2_to_int16_reordered(
+                                                    Im_in_g + (((i_ker_y * dim_im_in + i_ker_x) * ch_im_in) >> 2),
+                                                    pBuffer,
+                                                    ch_in_g,
+                                                    z_in);
+                            }
+                            pBuffer += ch_in_g;
+                        }
+                    }
+                }
+
+                if (pBuffer == bufferA + 2 * numCol)
+                {
+                    pOut = arm_nn_mat_mult_kernel_strided_reordered_u2_int16_u2_PACT_CH_thr(wt_g,
+                                                bufferA,
+                                                ch_out_g,
+                                                numCol,
+                                                bias_g,
+                                                pOut,
+                                                ch_im_out,
+                                                z_wt_g,
+                                                thresholds_g);
+                    /* counter reset */
+                    pBuffer = bufferA;
+                }
+            }
+        }
+
+        /* check if there is left-over for compute */
+        if (pBuffer != bufferA)
+        {
+            /* single pixel left: duplicate its column and compute it twice in place */
+            memcpy(pBuffer, bufferA, sizeof(int16_t) * numCol);
+            arm_nn_mat_mult_kernel_strided_reordered_u2_int16_u2_PACT_CH_thr(wt_g,
+                                                bufferA,
+                                                ch_out_g,
+                                                numCol,
+                                                bias_g,
+                                                pOut,
+                                                0,
+                                                z_wt_g,
+                                                thresholds_g);
+        }
+    }
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXConv group
+ */
\ No newline at end of file
@@ -0,0 +1,260 @@
+/* Copyright (C) 2020 University of Bologna
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+ /******************************************************************
+ * Project:      CMixNN Inference Library
+ * Title:        arm_convolve_pool_HWC_u2_u2_u2_PACT_CH_thr.c
+ * Description:  Mixed Precision Convolutional function with 2x2 pooling that uses u2
+ *               activations, u2 weights and produce u2
+ *               output activations. Outputs are quantized using thr
+ *               folding technique.
+ * Target:       ARM Cortex-M cores
+ *
+ * Date:         10 February 2020
+ * Revision:     Release v1.0.0
+ *
+ * Authors:      Alessandro Capotondi
+ *                 <alessandro.capotondi AT unibo.it>
+ *               Marco Fariselli
+ *                 <marco.fariselli AT greenwaves-technologies.com>
+ *               Manuele Rusci 
+ *                 <manuele.rusci AT unibo.it>
+ *
+ ******************************************************************/
+
+#include <assert.h>
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXConv
+ * @{
+ */
+
+  /**
+   * @brief Mixed Precision Convolution with 2x2 Pooling thr (in: u2, out: u2, wt: u2)
+   *
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimension
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       left_pad    padding sizes
+   * @param[in]       right_pad   padding sizes
+   * @param[in]       top_pad     padding sizes
+   * @param[in]       bottom_pad  padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       pool        CMIXNN_MAX_POOL or CMIXNN_AVG_POOL, 2x2 window and stride 2
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   Im_out      pointer to pooled output tensor, dim_im_out/2 x dim_im_out/2
+   * @param[in]       dim_im_out  convolution output tensor dimension
+   * @param[in]       z_in        input offset
+   * @param[in]       *z_wt       weights offset, per-output channel
+   * @param[in]       thresholds  pointer to thresholds
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   bufferB     pointer to buffer space for the sums of a pooling window, 4*ch_im_out int32_t (32-bit aligned)
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * The four convolution outputs of a pooling window are computed back to back, as two pixel pairs
+   * of the int32_t Matrix-Multiplication, and reduced on the accumulators: only the pooled value is
+   * quantized and stored. Max pooling gives the same result as pooling the quantized outputs: the
+   * quantization is non-decreasing in the accumulator, unless m_zero is negative (ICN folding of a
+   * negative BN gamma), and then the minimum accumulator of the channel is quantized instead.
+   * Average pooling quantizes the rounded mean of the accumulators.
+   * The last row and column of an odd dim_im_out are dropped. The weights have the same layout as
+   * the plain convolution.
+   */
+arm_status
+arm_convolve_pool_HWC_u2_u2_u2_PACT_CH_thr(const uint8_t *Im_in,
+                    const cmixnn_dim_t dim_im_in,
+                    const cmixnn_dim_t ch_im_in,
+                    const uint8_t *wt,
+                    const cmixnn_dim_t ch_im_out,
+                    const cmixnn_dim_t dim_kernel,
+                    const uint8_t left_padding,
+                    const uint8_t right_padding,
+                    const uint8_t top_padding,
+                    const uint8_t bottom_padding,
+                    const cmixnn_dim_t stride,
+                    const cmixnn_pool_t pool,
+                    const int32_t *bias,
+                    uint8_t *Im_out,
+                    const cmixnn_dim_t dim_im_out,
+                    const uint8_t z_in,
+                    const uint8_t *z_wt,
+                    const int16_t *thresholds,
+                    int16_t * bufferA,
+                    uint8_t *bufferB)
+{
+
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    cmixnn_idx_t i_out_y, i_out_x, i_ker_y, i_ker_x;
+    cmixnn_idx_t i_pool_y, i_pool_x;
+    int16_t *pBuffer = bufferA;
+    uint8_t *pOut = Im_out;
+    int32_t *pSum = (int32_t *) bufferB;
+    const cmixnn_dim_t numCol = ch_im_in * dim_kernel * dim_kernel;
+    const cmixnn_dim_t dim_pool_out = dim_im_out >> 1;
+    cmixnn_dim_t i_ch, i_row, i_col;
+
+    if (ch_im_in % 4 != 0 || ch_im_out % 4 != 0)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    for (i_pool_y = 0; i_pool_y < dim_pool_out; i_pool_y++)
+    {
+        for (i_pool_x = 0; i_pool_x < dim_pool_out; i_pool_x++)
+        {
+            /* each row of the pooling window is a pixel pair of the Matrix-Multiplication */
+            for (i_row = 0; i_row < 2; i_row++)
+            {
+                /* This part implements the im2col function */
+                pBuffer = bufferA;
+                i_out_y = 2 * i_pool_y + i_row;
+                for (i_col = 0; i_col < 2; i_col++)
+                {
+                    i_out_x = 2 * i_pool_x + i_col;
+                    if (ch_im_in % 16 != 0)
+                    {
+                        /* pixels do not fill whole vectors: gather the packed window, padded with z_in, and convert it at once */
+                        arm_u2_to_int16_reordered(__im2col_gather(Im_in, dim_im_in, ch_im_in, ch_im_in, 2,
+                                                                    i_out_y * stride - top_padding, i_out_x * stride - left_padding,
+                                                                    dim_kernel, dim_kernel, 1, z_in, pBuffer, numCol),
+                                                    pBuffer,
+                                                    numCol,
+                                                    z_in);
+                        pBuffer += numCol;
+                        continue;
+                    }
+                    for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+                    {
+                        if (i_ker_y < 0 || i_ker_y >= dim_im_in)
+                        {
+                            memset(pBuffer, 0, sizeof(int16_t) * ch_im_in * dim_kernel);
+                            pBuffer += ch_im_in * dim_kernel;
+                        }
+                        else if (i_out_x * stride - left_padding >= 0
+                                 && i_out_x * stride - left_padding + dim_kernel <= dim_im_in)
+                        {
+                            /* the kernel row lies in the input: load it at once */
+                            arm_u2_to_int16_reordered(
+                                                Im_in + (((i_ker_y * dim_im_in + i_out_x * stride - left_padding) * ch_im_in) >> 2),
+                                                pBuffer,
+                                                ch_im_in * dim_kernel,
+                                                z_in);
+                            pBuffer += ch_im_in * dim_kernel;
+                        }
+                        else
+                        {
+                            for (i_ker_x = i_out_x * stride - left_padding; i_ker_x < i_out_x * stride - left_padding + dim_kernel; i_ker_x++)
+                            {
+                                if (i_ker_x < 0 || i_ker_x >= dim_im_in)
+                                {
+                                    memset(pBuffer, 0, sizeof(int16_t) * ch_im_in);
+                                }
+                                else
+                                {
+                                    arm_u2_to_int16_reordered(
+                                                Im_in + (((i_ker_y * dim_im_in + i_ker_x) * ch_im_in) >> 2),
+                                                pBuffer,
+                                                ch_im_in,
+                                                z_in);
+                                }
+                                pBuffer += ch_im_in;
+                            }
+                        }
+                    }
+                }
+
+                /* sums of the pixel pair start from the bias */
+                for (i_ch = 0; i_ch < ch_im_out; i_ch++)
+                {
+                    pSum[2 * i_row * ch_im_out + i_ch] = bias[i_ch];
+                    pSum[(2 * i_row + 1) * ch_im_out + i_ch] = bias[i_ch];
+                }
+                arm_nn_mat_mult_kernel_partial_reordered_u2_int16_int32_PACT_CH(wt,
+                                                bufferA,
+                                                ch_im_out,
+                                                numCol,
+                                                numCol,
+                                                numCol,
+                                                numCol,
+                                                pSum + 2 * i_row * ch_im_out,
+                                                z_wt);
+            }
+
+            /* reduce the window on the accumulators, then quantize */
+            pOut = Im_out + (((i_pool_y * dim_pool_out + i_pool_x) * ch_im_out) >> 2);
+            for (i_ch = 0; i_ch < ch_im_out; i_ch++)
+            {
+                int32_t sum = pSum[i_ch];
+                int32_t sum2 = pSum[ch_im_out + i_ch];
+                int32_t sum3 = pSum[2 * ch_im_out + i_ch];
+                int32_t sum4 = pSum[3 * ch_im_out + i_ch];
+
+                if (pool == CMIXNN_MAX_POOL)
+                {
+                    sum = (sum2 > sum) ? sum2 : sum;
+                    sum3 = (sum4 > sum3) ? sum4 : sum3;
+                    sum = (sum3 > sum) ? sum3 : sum;
+                }
+                else
+                {
+                    sum = (sum + sum2 + sum3 + sum4 + 2) >> 2;
+                }
+
+                /* Normalize by Thresholds (u2 output) */
+                sum = __int16_to_u2((int16_t) sum, &thresholds[i_ch << 2]);
+
+                /* Store Outputs (u2 output) */
+                if (i_ch & 0x3)
+                {
+                    *pOut |= __USAT(sum, 2) << ((i_ch & 0x3) << 1);
+                }
+                else
+                {
+                    *pOut = __USAT(sum, 2);
+                }
+                pOut += ((i_ch & 0x3) == 0x3);
+            }
+        }
+    }
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXConv group
+ */
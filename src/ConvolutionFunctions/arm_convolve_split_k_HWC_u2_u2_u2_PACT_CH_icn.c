@@ -0,0 +1,253 @@
+/* Copyright (C) 2020 University of Bologna
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+ /******************************************************************
+ * Project:      CMixNN Inference Library
+ * Title:        arm_convolve_split_k_HWC_u2_u2_u2_PACT_CH_icn.c
+ * Description:  Mixed Precision Split-K Convolutional function that uses u2
+ *               activations, u2 weights and produce u2
+ *               output activations. Outputs are quantized using icn
+ *               folding technique.
+ * Target:       ARM Cortex-M cores
+ *
+ * Date:         10 February 2020
+ * Revision:     Release v1.0.0
+ *
+ * Authors:      Alessandro Capotondi
+ *                 <alessandro.capotondi AT unibo.it>
+ *               Marco Fariselli
+ *                 <marco.fariselli AT greenwaves-technologies.com>
+ *               Manuele Rusci 
+ *                 <manuele.rusci AT unibo.it>
+ *
+ ******************************************************************/
+
+#include <assert.h>
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXConv
+ * @{
+ */
+
+  /**
+   * @brief Mixed Precision Split-K Convolution icn (in: u2, out: u2, wt: u2)
+   *
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimension
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       left_pad    padding sizes
+   * @param[in]       right_pad   padding sizes
+   * @param[in]       top_pad     padding sizes
+   * @param[in]       bottom_pad  padding sizes
+   * @param[in]       stride      convolution stride
+   * @param[in]       bufferA_size  number of int16_t elements available in bufferA
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       z_in        input offset
+   * @param[in]       *z_wt       weights offset, per-output channel
+   * @param[in]       z_out       output offset
+   * @param[in]       *m_zero     pointer to m zero quantization params (per-output-ch)
+   * @param[in]       *n_zero     pointer to n zero quantization params (per-output-ch)
+   * @param[in,out]   bufferA     pointer to buffer space for input
+   * @param[in,out]   bufferB     pointer to buffer space for the partial sums, 2*ch_im_out int32_t (32-bit aligned)
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * The input channels are processed in chunks of ch_in_chunk channels, the largest multiple
+   * of 16 dividing ch_im_in such that 2*ch_in_chunk*dim_kernel*dim_kernel <= bufferA_size.
+   * The int32_t sums of the current output pixel pair are kept in bufferB across the chunks and
+   * quantized after the last one. The weights have the same layout as the plain convolution.
+   * A single chunk is used when the whole layer fits bufferA, with no constraint on ch_im_in.
+   */
+arm_status
+arm_convolve_split_k_HWC_u2_u2_u2_PACT_CH_icn(const uint8_t *Im_in,
+                    const cmixnn_dim_t dim_im_in,
+                    const cmixnn_dim_t ch_im_in,
+                    const uint8_t *wt,
+                    const cmixnn_dim_t ch_im_out,
+                    const cmixnn_dim_t dim_kernel,
+                    const uint8_t left_padding,
+                    const uint8_t right_padding,
+                    const uint8_t top_padding,
+                    const uint8_t bottom_padding,
+                    const cmixnn_dim_t stride,
+                    const cmixnn_dim_t bufferA_size,
+                    const int32_t *bias,
+                    uint8_t *Im_out,
+                    const cmixnn_dim_t dim_im_out,
+                    const uint8_t z_in,
+                    const uint8_t *z_wt,
+                    const uint8_t z_out,
+                    const int32_t *m_zero,
+                    const int8_t *n_zero,
+                    int16_t * bufferA,
+                    uint8_t *bufferB)
+{
+
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    cmixnn_idx_t i_out_y, i_out_x, i_ker_y, i_ker_x;
+    int16_t *pBuffer = bufferA;
+    uint8_t *pOut = Im_out;
+    int32_t *pSum = (int32_t *) bufferB;
+    const cmixnn_dim_t numCol = ch_im_in * dim_kernel * dim_kernel;
+    cmixnn_dim_t ch_in_chunk = ch_im_in;
+    int32_t i_pix, i_pix2;
+    cmixnn_dim_t i_ch, i_pair;
+
+    if (ch_im_in % 4 != 0 || ch_im_out % 4 != 0)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    if (2 * numCol > bufferA_size)
+    {
+        /* largest chunk of whole 32-bit vectors of activations and weights that fits bufferA */
+        ch_in_chunk = bufferA_size / (2 * dim_kernel * dim_kernel);
+        ch_in_chunk -= ch_in_chunk % 16;
+        while (ch_in_chunk > 0 && ch_im_in % ch_in_chunk != 0)
+        {
+            ch_in_chunk -= 16;
+        }
+        if (ch_in_chunk == 0)
+        {
+            /* the input channels cannot be split in chunks fitting bufferA */
+            return ARM_MATH_SIZE_MISMATCH;
+        }
+    }
+
+    /* columns of one chunk, read from the weights in segments of ch_in_chunk every ch_im_in columns */
+    const cmixnn_dim_t numColChunk = ch_in_chunk * dim_kernel * dim_kernel;
+    const cmixnn_dim_t seg_len = (ch_in_chunk == ch_im_in) ? numCol : ch_in_chunk;
+    const cmixnn_dim_t seg_stride = (ch_in_chunk == ch_im_in) ? numCol : ch_im_in;
+
+    for (i_pix = 0; i_pix < dim_im_out * dim_im_out; i_pix += 2)
+    {
+        /* the last pixel of an odd output is computed twice in place */
+        i_pix2 = (i_pix + 1 < dim_im_out * dim_im_out) ? i_pix + 1 : i_pix;
+
+        /* partial sums start from the bias */
+        for (i_ch = 0; i_ch < ch_im_out; i_ch++)
+        {
+            pSum[i_ch] = bias[i_ch];
+            pSum[ch_im_out + i_ch] = bias[i_ch];
+        }
+
+        for (i_ch = 0; i_ch < ch_im_in; i_ch += ch_in_chunk)
+        {
+            /* This part implements the im2col function over the channel chunk */
+            pBuffer = bufferA;
+            for (i_pair = 0; i_pair < 2; i_pair++)
+            {
+                i_out_y = ((i_pair == 0) ? i_pix : i_pix2) / dim_im_out;
+                i_out_x = ((i_pair == 0) ? i_pix : i_pix2) % dim_im_out;
+                if (ch_in_chunk % 16 != 0)
+                {
+                    /* a single chunk whose pixels do not fill whole vectors: gather the packed window, padded with z_in,
+                       and convert it at once */
+                    arm_u2_to_int16_reordered(__im2col_gather(Im_in, dim_im_in, ch_im_in, ch_im_in, 2,
+                                                                i_out_y * stride - top_padding, i_out_x * stride - left_padding,
+                                                                dim_kernel, dim_kernel, 1, z_in, pBuffer, numColChunk),
+                                                pBuffer,
+                                                numColChunk,
+                                                z_in);
+                    pBuffer += numColChunk;
+                    continue;
+                }
+                for (i_ker_y = i_out_y * stride - top_padding; i_ker_y < i_out_y * stride - top_padding + dim_kernel; i_ker_y++)
+                {
+                    for (i_ker_x = i_out_x * stride - left_padding; i_ker_x < i_out_x * stride - left_padding + dim_kernel; i_ker_x++)
+                    {
+                        if (i_ker_y < 0 || i_ker_y >= dim_im_in || i_ker_x < 0 || i_ker_x >= dim_im_in)
+                        {
+                            memset(pBuffer, 0, sizeof(int16_t) * ch_in_chunk);
+                        }
+                        else
+                        {
+                            arm_u2_to_int16_reordered(
+                                                Im_in + (((i_ker_y * dim_im_in + i_ker_x) * ch_im_in + i_ch) >> 2),
+                                                pBuffer,
+                                                ch_in_chunk,
+                                                z_in);
+                        }
+                        pBuffer += ch_in_chunk;
+                    }
+                }
+            }
+
+            if (i_ch + ch_in_chunk < ch_im_in)
+            {
+                arm_nn_mat_mult_kernel_partial_reordered_u2_int16_int32_PACT_CH(
+                                                wt + (i_ch >> 2),
+                                                bufferA,
+                                                ch_im_out,
+                                                numColChunk,
+                                                seg_len,
+                                                seg_stride,
+                                                numCol,
+                                                pSum,
+                                                z_wt);
+            }
+            else
+            {
+                /* last chunk: quantize the output pixel pair */
+                pOut = Im_out + (((i_pix) * ch_im_out) >> 2);
+                arm_nn_mat_mult_kernel_partial_reordered_u2_int16_u2_PACT_CH_icn(
+                                                wt + (i_ch >> 2),
+                                                bufferA,
+                                                ch_im_out,
+                                                numColChunk,
+                                                seg_len,
+                                                seg_stride,
+                                                numCol,
+                                                pSum,
+                                                pOut,
+                                                (i_pix2 - i_pix) * ch_im_out,
+                                                z_wt,
+                                                z_out,
+                                                m_zero,
+                                                n_zero);
+            }
+        }
+    }
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXConv group
+ */
\ No newline at end of file
@@ -0,0 +1,236 @@
+/* Copyright (C) 2020 University of Bologna
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+ /******************************************************************
+ * Project:      CMixNN Inference Library
+ * Title:        arm_convolve_transposed_HWC_u2_u2_u2_PACT_CH_thr.c
+ * Description:  Mixed Precision Transposed Convolutional function that uses u2
+ *               activations, u2 weights and produce u2
+ *               output activations. Outputs are quantized using thr
+ *               folding technique.
+ * Target:       ARM Cortex-M cores
+ *
+ * Date:         10 February 2020
+ * Revision:     Release v1.0.0
+ *
+ * Authors:      Alessandro Capotondi
+ *                 <alessandro.capotondi AT unibo.it>
+ *               Marco Fariselli
+ *                 <marco.fariselli AT greenwaves-technologies.com>
+ *               Manuele Rusci 
+ *                 <manuele.rusci AT unibo.it>
+ *
+ ******************************************************************/
+
+#include <assert.h>
+
+#include "arm_cmixnn.h"
+
+/**
+ *  @ingroup CMIXNN
+ */
+
+/**
+ * @addtogroup CMIXConv
+ * @{
+ */
+
+  /**
+   * @brief Mixed Precision Transposed Convolution thr (in: u2, out: u2, wt: u2)
+   *
+   * @param[in]       Im_in       pointer to input tensor
+   * @param[in]       dim_im_in   input tensor dimension
+   * @param[in]       ch_im_in    number of input tensor channels
+   * @param[in]       wt          pointer to kernel weights, stored phase by phase (see details)
+   * @param[in]       ch_im_out   number of filters, i.e., output tensor channels
+   * @param[in]       dim_kernel  filter kernel size
+   * @param[in]       left_pad    padding sizes
+   * @param[in]       right_pad   padding sizes
+   * @param[in]       top_pad     padding sizes
+   * @param[in]       bottom_pad  padding sizes
+   * @param[in]       stride      upsampling stride
+   * @param[in]       bias        pointer to bias
+   * @param[in,out]   Im_out      pointer to output tensor
+   * @param[in]       dim_im_out  output tensor dimension
+   * @param[in]       z_in        input offset
+   * @param[in]       *z_wt       weights offset, per-output channel
+   * @param[in]       thresholds  pointer to thresholds
+   * @param[in,out]   bufferA     pointer to buffer space for input, 2*ch_im_in*ceil(dim_kernel/stride)^2 int16_t
+   * @param[in,out]   bufferB     pointer to buffer space for output
+   * @return     The function returns either
+   * <code>ARM_MATH_SIZE_MISMATCH</code> or <code>ARM_MATH_SUCCESS</code> based on the outcome of size checking.
+   *
+   * @details
+   *
+   * Out[oy][ox] accumulates In[iy][ix] * Wt[ky][kx] for every oy = iy*stride - top_padding + ky
+   * (and likewise along x). The outputs are computed by phase: all the output pixels sharing
+   * ky0 = (oy + top_padding) % stride and kx0 = (ox + left_padding) % stride are produced by a
+   * regular convolution with the sub-kernel {ky0 + i*stride} x {kx0 + j*stride}. Hence, only
+   * the non-zero contributions are gathered and no zero-inserted input tensor is needed.
+   *
+   * The weights are stored phase by phase, with (ky0, kx0) in row-major order. Each phase holds
+   * the ch_im_out filters of its sub-kernel, laid out as [ch_im_out][i][j][ch_im_in], where i and j
+   * index the taps ky0 + i*stride and kx0 + j*stride.
+   *
+   * dim_kernel must not be smaller than stride, so that every phase has at least one tap.
+   */
+arm_status
+arm_convolve_transposed_HWC_u2_u2_u2_PACT_CH_thr(const uint8_t *Im_in,
+                    const cmixnn_dim_t dim_im_in,
+                    const cmixnn_dim_t ch_im_in,
+                    const uint8_t *wt,
+                    const cmixnn_dim_t ch_im_out,
+                    const cmixnn_dim_t dim_kernel,
+                    const uint8_t left_padding,
+                    const uint8_t right_padding,
+                    const uint8_t top_padding,
+                    const uint8_t bottom_padding,
+                    const cmixnn_dim_t stride,
+                    const int32_t *bias,
+                    uint8_t *Im_out,
+                    const cmixnn_dim_t dim_im_out,
+                    const uint8_t z_in,
+                    const uint8_t *z_wt,
+                    const int16_t *thresholds,
+                    int16_t * bufferA,
+                    uint8_t *bufferB)
+{
+
+#if defined(ARM_MATH_DSP)
+    /* Run the following code for Cortex-M4 and Cortex-M7 */
+
+    cmixnn_idx_t i_out_y, i_out_x, i_in_y, i_in_x;
+    cmixnn_idx_t ker_y0, ker_x0, i_ker_y, i_ker_x;
+    int16_t *pBuffer = bufferA;
+    uint8_t *pOut;
+    const uint8_t *wt_ph = wt;
+
+    if (ch_im_in % 4 != 0 || ch_im_out % 4 != 0 || dim_kernel < stride)
+    {
+        /* check if the input dimension meets the constraints */
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+
+    for (ker_y0 = 0; ker_y0 < stride; ker_y0++)
+    {
+        /* taps of the phase along y and first output row using them */
+        const cmixnn_idx_t n_ker_y = (dim_kernel - ker_y0 + stride - 1) / stride;
+        const cmixnn_idx_t out_y0 = ((ker_y0 - top_padding) % stride + stride) % stride;
+
+        for (ker_x0 = 0; ker_x0 < stride; ker_x0++)
+        {
+            /* taps of the phase along x and first output column using them */
+            const cmixnn_idx_t n_ker_x = (dim_kernel - ker_x0 + stride - 1) / stride;
+            const cmixnn_idx_t out_x0 = ((ker_x0 - left_padding) % stride + stride) % stride;
+            const cmixnn_dim_t numCol = n_ker_y * n_ker_x * ch_im_in;
+
+            for (i_out_y = out_y0; i_out_y < dim_im_out; i_out_y += stride)
+            {
+                for (i_out_x = out_x0; i_out_x < dim_im_out; i_out_x += stride)
+                {
+                    if (ch_im_in % 16 != 0)
+                    {
+                        /* pixels do not fill whole vectors: gather the packed taps of the phase, walking the input
+                           backwards and padded with z_in, and convert them at once */
+                        arm_u2_to_int16_reordered(__im2col_gather(Im_in, dim_im_in, ch_im_in, ch_im_in, 2,
+                                                                    (i_out_y + top_padding - ker_y0) / stride,
+                                                                    (i_out_x + left_padding - ker_x0) / stride,
+                                                                    n_ker_y, n_ker_x, -1, z_in, pBuffer, numCol),
+                                                    pBuffer,
+                                                    numCol,
+                                                    z_in);
+                        pBuffer += numCol;
+                    }
+                    else
+                    {
+                        /* This part implements the im2col function over the taps of the phase */
+                        for (i_ker_y = 0; i_ker_y < n_ker_y; i_ker_y++)
+                        {
+                            i_in_y = (i_out_y + top_padding - ker_y0) / stride - i_ker_y;
+                            for (i_ker_x = 0; i_ker_x < n_ker_x; i_ker_x++)
+                            {
+                                i_in_x = (i_out_x + left_padding - ker_x0) / stride - i_ker_x;
+                                if (i_in_y < 0 || i_in_y >= dim_im_in || i_in_x < 0 || i_in_x >= dim_im_in)
+                                {
+                                    memset(pBuffer, 0, sizeof(int16_t) * ch_im_in);
+                                }
+                                else
+                                {
+                                    arm_u2_to_int16_reordered(
+                                                    Im_in + (((i_in_y * dim_im_in + i_in_x) * ch_im_in) >> 2),
+                                                    pBuffer,
+                                                    ch_im_in,
+                                                    z_in);
+                                }
+                                pBuffer += ch_im_in;
+                            }
+                        }
+                    }
+
+                    if (pBuffer == bufferA + 2 * numCol || i_out_x + stride >= dim_im_out)
+                    {
+                        cmixnn_dim_t ch_out_stride = stride * ch_im_out;
+
+                        if (pBuffer != bufferA + 2 * numCol)
+                        {
+                            /* last pixel of the row has no partner: compute it twice in place */
+                            memcpy(pBuffer, bufferA, sizeof(int16_t) * numCol);
+                            ch_out_stride = 0;
+                        }
+                        else
+                        {
+                            /* first pixel of the pair */
+                            i_out_x -= stride;
+                        }
+
+                        pOut = Im_out + (((i_out_y * dim_im_out + i_out_x) * ch_im_out) >> 2);
+                        arm_nn_mat_mult_kernel_strided_reordered_u2_int16_u2_PACT_CH_thr(wt_ph,
+                                                bufferA,
+                                                ch_im_out,
+                                                numCol,
+                                                bias,
+                                                pOut,
+                                                ch_out_stride,
+                                                z_wt,
+                                                thresholds);
+                        if (ch_out_stride != 0)
+                        {
+                            i_out_x += stride;
+                        }
+                        /* counter reset */
+                        pBuffer = bufferA;
+                    }
+                }
+            }
+
+            /* move to the sub-kernel of the next phase */
+            wt_ph += ch_im_out * ((numCol + 3) >> 2);
+        }
+    }
+
+#else
+#error "Cortex-M0 and Cortex-M3 not supported"
+    /* Run the following code as reference implementation for Cortex-M0 and Cortex-M3 */
+#endif /* ARM_MATH_DSP */
+
+    /* Return to application */
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @} end of CMIXConv group
+ */
\ No newline at end of file